@@ -0,0 +1,35 @@
+#include "application/services/RunStatistics.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if SAA_ENABLE_STATS
+// Đếm allocations bằng replacement của global operator new. File này chỉ link vào
+// executable (benchmark và tools dùng default operator new của core library).
+// Array, nothrow và sized-delete forms của libstdc++/libc++ đều đi qua các functions này
+void* operator new(std::size_t size)
+{
+    for (;;) {
+        if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+            application::services::recordAllocation(size);
+            return memory;
+        }
+        // Như default operator new: gọi new_handler rồi thử lại, không có handler thì throw
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t /*size*/) noexcept
+{
+    std::free(memory);
+}
+#endif
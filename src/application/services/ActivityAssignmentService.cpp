@@ -1,12 +1,66 @@
 #include "ActivityAssignmentService.h"
+#include "../strategies/AssignmentKernel.h"
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
 #include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
 
 namespace application::services {
 
-// Static member definition
-constexpr std::array<domain::entities::ActivityCategory, 3> 
-ActivityAssignmentService::REQUIRED_CATEGORIES;
+namespace {
+
+// Số students xử lý mỗi lần trong một worker, để draw buffer nằm trong cache.
+// Bằng stratum size để mỗi block ứng với đúng một stratum
+constexpr std::size_t PARALLEL_BLOCK_SIZE = strategies::DRAW_STRATUM_SIZE;
+
+// Round chunk size lên bội số của stratum size
+[[nodiscard]] constexpr std::size_t alignToStratum(std::size_t size) noexcept
+{
+    return (size + strategies::DRAW_STRATUM_SIZE - 1) / strategies::DRAW_STRATUM_SIZE
+        * strategies::DRAW_STRATUM_SIZE;
+}
+
+// Activity id trong state cũ không còn trong catalog hiện tại
+constexpr domain::entities::ActivityId UNMAPPED_ACTIVITY = std::numeric_limits<domain::entities::ActivityId>::max();
+
+// Map ids của catalog cũ sang catalog hiện tại theo (name, category); keys và mapping
+// allocate từ scratch resource của run
+[[nodiscard]] std::pmr::vector<domain::entities::ActivityId> remapActivities(
+    std::span<const domain::entities::Activity> previous,
+    const domain::entities::ActivityIndex& catalog,
+    std::pmr::memory_resource* resource)
+{
+    auto key = [resource](const domain::entities::Activity& activity) {
+        std::pmr::string result(activity.getName(), resource);
+        result += '\n';
+        result += std::to_string(static_cast<unsigned>(activity.getCategory()));
+        return result;
+    };
+
+    std::pmr::unordered_map<std::pmr::string, domain::entities::ActivityId> current(resource);
+    const auto activities = catalog.getActivities();
+    for (std::size_t id = 0; id < activities.size(); ++id) {
+        current.emplace(key(activities[id]), static_cast<domain::entities::ActivityId>(id));
+    }
+
+    std::pmr::vector<domain::entities::ActivityId> mapping(resource);
+    mapping.reserve(previous.size());
+    for (const auto& activity : previous) {
+        auto it = current.find(key(activity));
+        mapping.push_back(it != current.end() ? it->second : UNMAPPED_ACTIVITY);
+    }
+    return mapping;
+}
+
+} // namespace
 
 // Constructor implementation
 ActivityAssignmentService::ActivityAssignmentService(
@@ -19,55 +73,584 @@ ActivityAssignmentService::ActivityAssignmentService(
 {
 }
 
-// AssignmentResult constructor implementation
-ActivityAssignmentService::AssignmentResult::AssignmentResult(domain::entities::Student s)
-    : student(std::move(s))
+double ActivityAssignmentService::WorkerStats::studentsPerSecond() const noexcept
 {
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0.0 ? static_cast<double>(studentCount) / seconds : 0.0;
+}
+
+// AssignmentSet lookups
+const domain::entities::Student& ActivityAssignmentService::AssignmentSet::studentOf(
+    const AssignmentResult& result) const noexcept
+{
+    return (*students)[result.studentIndex];
+}
+
+const domain::entities::Activity& ActivityAssignmentService::AssignmentSet::activityOf(
+    domain::entities::ActivityId id) const noexcept
+{
+    return catalog.getActivity(id);
 }
 
 // Main business logic method implementation
-std::optional<std::vector<ActivityAssignmentService::AssignmentResult>>
+std::optional<ActivityAssignmentService::AssignmentSet>
 ActivityAssignmentService::assignActivitiesToStudents() const
 {
+    std::lock_guard lock(mutex_);
+    RunStatistics statistics;
+
+    // Roster, results và draw buffers của run nằm trong một arena
+    const auto arena = makeArena();
+    auto* resource = resourceOf(arena);
+
     // Load data
-    auto studentsOpt = studentRepo_->loadStudents();
-    if (!studentsOpt) {
+    PhaseTimer rosterTimer { statistics, RunPhase::Load };
+    auto roster = studentRepo_->loadSharedStudents(resource);
+    rosterTimer.stop();
+    if (!roster) {
+        return std::nullopt;
+    }
+
+    auto catalogOpt = loadCatalog(statistics);
+    if (!catalogOpt) {
         return std::nullopt;
     }
 
+    // Results được construct tại chỗ trong arena (assign sẽ copy sang default resource)
+    const std::size_t studentCount = roster->size();
+    const std::size_t categoryCount = catalogOpt->categoryCount();
+    AssignmentSet assignment {
+        .memory = arena,
+        .students = std::move(roster),
+        .catalog = std::move(*catalogOpt),
+        .results = AssignmentTable(categoryCount, studentCount, resource),
+        .workerStats = {},
+        .statistics = statistics
+    };
+
+    if (!assignRange(assignment.catalog, 0, assignment.results, assignment.workerStats, assignment.statistics,
+            resource)) {
+        return std::nullopt;
+    }
+
+    if (capacityConstrained_) {
+        CapacityLedger ledger { assignment.catalog };
+        if (!applyCapacities(assignment.catalog, ledger, assignment.results, assignment.students->size(),
+                assignment.statistics)) {
+            return std::nullopt;
+        }
+    }
+
+    assignment.statistics.studentCount = assignment.students->size();
+    return assignment;
+}
+
+// Incremental mode: chỉ draw cho delta của roster so với previous state
+std::optional<ActivityAssignmentService::IncrementalAssignment>
+ActivityAssignmentService::assignActivitiesIncrementally(
+    const domain::repositories::AssignmentState& previous) const
+{
+    std::lock_guard lock(mutex_);
+    RunStatistics statistics;
+
+    // Arena của assignment; bookkeeping của delta nằm trong scratch arena, release khi return
+    const auto arena = makeArena();
+    auto* resource = resourceOf(arena);
+    const auto scratchArena = makeArena();
+    auto* scratch = resourceOf(scratchArena);
+
+    PhaseTimer rosterTimer { statistics, RunPhase::Load };
+    auto roster = studentRepo_->loadSharedStudents(resource);
+    rosterTimer.stop();
+    if (!roster) {
+        return std::nullopt;
+    }
+
+    auto catalogOpt = loadCatalog(statistics);
+    if (!catalogOpt) {
+        return std::nullopt;
+    }
+
+    // State cũ phải có cùng số categories per student với catalog hiện tại
+    const std::size_t stride = catalogOpt->categoryCount();
+    if (!previous.studentIds.empty() && previous.categoriesPerStudent != stride) {
+        lastError_ = "State file has " + std::to_string(previous.categoriesPerStudent)
+            + " categories per student but the catalog has " + std::to_string(stride);
+        return std::nullopt;
+    }
+
+    const std::size_t studentCount = roster->size();
+    IncrementalAssignment incremental {
+        .assignment = {
+            .memory = arena,
+            .students = std::move(roster),
+            .catalog = std::move(*catalogOpt),
+            .results = AssignmentTable(stride, studentCount, resource),
+            .workerStats = {},
+            .statistics = statistics },
+        .state = {},
+        .stats = {}
+    };
+    auto& assignment = incremental.assignment;
+    const auto& students = *assignment.students;
+    const auto& catalog = assignment.catalog;
+    const auto categories = catalog.getCategories();
+
+    const auto mapping = remapActivities(previous.activities, catalog, scratch);
+
+    // present: student còn trong roster; kept: assignment cũ vẫn valid và được giữ
+    std::pmr::vector<bool> present(previous.studentIds.size(), false, scratch);
+    std::pmr::vector<bool> kept(previous.studentIds.size(), false, scratch);
+    std::pmr::vector<std::uint32_t> pending(scratch);
+
+    for (std::size_t i = 0; i < students.size(); ++i) {
+        assignment.results.studentIndices()[i] = static_cast<std::uint32_t>(i);
+        const auto activityIds = assignment.results.activityIdsOf(i);
+
+        const auto packedId = students[i].getPackedId();
+        auto it = std::ranges::lower_bound(previous.studentIds, packedId);
+        if (it != previous.studentIds.end() && *it == packedId) {
+            const auto position = static_cast<std::size_t>(it - previous.studentIds.begin());
+            present[position] = true;
+
+            bool valid = true;
+            for (std::size_t c = 0; c < stride; ++c) {
+                const auto id = mapping[previous.activityIds[position * stride + c]];
+                valid = valid && id != UNMAPPED_ACTIVITY
+                    && catalog.getActivity(id).getCategory() == categories[c];
+                activityIds[c] = id;
+            }
+            if (valid) {
+                kept[position] = true;
+                continue;
+            }
+        }
+        pending.push_back(static_cast<std::uint32_t>(i));
+    }
+
+    // Roster có thể lặp lại một ID: chỉ occurrence đầu tiên được draw, các occurrences sau
+    // copy assignment của nó. State giữ một entry mỗi packed id, nên rerun trên cùng roster
+    // phải thấy đúng assignment đó ở mọi occurrence
+    auto packedIdOf = [&](std::uint32_t i) { return students[i].getPackedId(); };
+    std::pmr::vector<std::uint32_t> pendingById(pending.begin(), pending.end(), scratch);
+    std::ranges::stable_sort(pendingById, {}, packedIdOf);
+
+    std::pmr::vector<std::pair<std::uint32_t, std::uint32_t>> repeats(scratch); // {occurrence, first}
+    std::pmr::vector<bool> repeated(students.size(), false, scratch);
+    for (std::size_t k = 1, first = 0; k < pendingById.size(); ++k) {
+        if (packedIdOf(pendingById[k]) != packedIdOf(pendingById[first])) {
+            first = k;
+            continue;
+        }
+        repeats.emplace_back(pendingById[k], pendingById[first]);
+        repeated[pendingById[k]] = true;
+    }
+    std::erase_if(pending, [&](std::uint32_t i) { return repeated[i]; });
+    std::erase_if(pendingById, [&](std::uint32_t i) { return repeated[i]; });
+
+    // Draw cho delta với counters tiếp theo sau run trước
+    AssignmentTable delta(stride, pending.size(), scratch);
+    if (!assignRange(catalog, previous.drawCount, delta, assignment.workerStats, assignment.statistics, scratch)) {
+        return std::nullopt;
+    }
+
+    if (capacityConstrained_) {
+        CapacityLedger ledger { catalog };
+        for (std::size_t i = 0, next = 0; i < students.size(); ++i) {
+            if (next < pending.size() && pending[next] == i) {
+                ++next;
+                continue;
+            }
+            if (repeated[i]) {
+                continue;
+            }
+            for (auto id : assignment.results[i].activityIds) {
+                ledger.consume(id);
+            }
+        }
+        if (!applyCapacities(catalog, ledger, delta, students.size(), assignment.statistics)) {
+            return std::nullopt;
+        }
+    }
+
+    for (std::size_t j = 0; j < pending.size(); ++j) {
+        std::ranges::copy(delta[j].activityIds, assignment.results.activityIdsOf(pending[j]).begin());
+    }
+    for (const auto& [occurrence, first] : repeats) {
+        std::ranges::copy(assignment.results[first].activityIds, assignment.results.activityIdsOf(occurrence).begin());
+    }
+
+    // State mới = entries được giữ (đã sorted) merge với delta sorted theo packed id
+    auto& state = incremental.state;
+    state.activities.assign(catalog.getActivities().begin(), catalog.getActivities().end());
+    state.categoriesPerStudent = stride;
+    state.drawCount = alignToStratum(previous.drawCount + pending.size());
+
+    const std::size_t keptEntries = static_cast<std::size_t>(std::ranges::count(kept, true));
+    state.studentIds.reserve(keptEntries + pendingById.size());
+    state.activityIds.reserve((keptEntries + pendingById.size()) * stride);
+
+    auto appendNew = [&](std::uint32_t i) {
+        state.studentIds.push_back(students[i].getPackedId());
+        const auto ids = assignment.results[i].activityIds;
+        state.activityIds.insert(state.activityIds.end(), ids.begin(), ids.end());
+    };
+
+    auto next = pendingById.begin();
+    for (std::size_t position = 0; position < previous.studentIds.size(); ++position) {
+        if (!kept[position]) {
+            continue;
+        }
+        for (; next != pendingById.end() && packedIdOf(*next) < previous.studentIds[position]; ++next) {
+            appendNew(*next);
+        }
+        state.studentIds.push_back(previous.studentIds[position]);
+        for (std::size_t c = 0; c < stride; ++c) {
+            state.activityIds.push_back(mapping[previous.activityIds[position * stride + c]]);
+        }
+    }
+    for (; next != pendingById.end(); ++next) {
+        appendNew(*next);
+    }
+
+    assignment.statistics.studentCount = students.size();
+    incremental.stats = {
+        .keptCount = students.size() - delta.size() - repeats.size(),
+        .assignedCount = delta.size() + repeats.size(),
+        .removedCount = static_cast<std::size_t>(std::ranges::count(present, false))
+    };
+    return incremental;
+}
+
+// Streaming mode: đọc, assign và emit từng chunk, memory bounded bởi chunkSize
+std::optional<ActivityAssignmentService::StreamSummary>
+ActivityAssignmentService::assignActivitiesStreaming(
+    std::size_t chunkSize, const ChunkConsumer& consumer) const
+{
+    std::lock_guard lock(mutex_);
+    StreamSummary summary { .studentCount = 0, .workerStats = {}, .statistics = {} };
+    auto& statistics = summary.statistics;
+
+    auto catalogOpt = loadCatalog(statistics);
+    if (!catalogOpt) {
+        return std::nullopt;
+    }
+    const auto& catalog = *catalogOpt;
+
+    // Chunks align theo strata để strata không bị cắt giữa hai chunks
+    chunkSize = alignToStratum(chunkSize);
+
+    // Chunk buffers (roster, results) được reuse, allocate một lần từ run arena;
+    // draw buffers của mỗi chunk từ chunk arena, release sau mỗi chunk
+    const auto arena = makeArena();
+    auto* resource = resourceOf(arena);
+    const auto chunkArena = makeArena();
+
+    AssignmentTable results(catalog.categoryCount(), 0, resource);
+    results.reserve(chunkSize);
+    bool assigned = true;
+
+    // Ledger sống qua tất cả chunks để capacities áp dụng cho cả roster
+    std::optional<CapacityLedger> ledger;
+    if (capacityConstrained_) {
+        ledger.emplace(catalog);
+    }
+
+    // Đọc roster xen kẽ với các phases khác: Load = tổng thời gian stream trừ phần trong callback
+    const auto timedBefore = statistics.getTotalTime();
+    PhaseTimer streamTimer { statistics, RunPhase::Load };
+
+    const bool streamed = studentRepo_->streamStudents(chunkSize,
+        [&](std::span<const domain::entities::Student> students) {
+            results.resize(students.size());
+            // Global offset làm DrawContext.firstStudent: cùng seed cho cùng results như batch mode
+            const bool drawn = assignRange(catalog, summary.studentCount, results, summary.workerStats,
+                statistics, resourceOf(chunkArena));
+            if (chunkArena) {
+                chunkArena->release();
+            }
+            if (!drawn) {
+                assigned = false;
+                return false;
+            }
+            if (ledger && !applyCapacities(
+                    catalog, *ledger, results, summary.studentCount + students.size(), statistics)) {
+                assigned = false;
+                return false;
+            }
+            summary.studentCount += students.size();
+
+            PhaseTimer outputTimer { statistics, RunPhase::Output };
+            return consumer(AssignmentChunk { .students = students, .catalog = catalog, .results = results });
+        },
+        resource);
+
+    const auto callbackTime = statistics.getTotalTime() - timedBefore;
+    statistics.addPhaseTime(RunPhase::Load, -callbackTime);
+    streamTimer.stop();
+
+    if (!streamed || !assigned) {
+        return std::nullopt;
+    }
+    statistics.studentCount = summary.studentCount;
+    return summary;
+}
+
+// Load catalog, build index, validate và prepare strategy
+std::optional<domain::entities::ActivityIndex> ActivityAssignmentService::loadCatalog(RunStatistics& statistics) const
+{
+    PhaseTimer loadTimer { statistics, RunPhase::Load };
     auto activitiesOpt = activityRepo_->loadActivities();
+    loadTimer.stop();
     if (!activitiesOpt) {
+        lastError_ = activitiesOpt.error();
         return std::nullopt;
     }
+    lastError_.clear();
+
+    PhaseTimer validateTimer { statistics, RunPhase::Validate };
 
-    const auto& students = *studentsOpt;
-    const auto& activities = *activitiesOpt;
+    // Resident catalog vẫn đúng nếu activities không đổi: reuse index và strategy tables
+    if (residentMode_ && residentCatalog_
+        && std::ranges::equal(residentCatalog_->getActivities(), *activitiesOpt)) {
+        statistics.setCategories(residentCatalog_->getCategories());
+        return residentCatalog_;
+    }
+
+    // Build per-category index một lần cho cả run
+    domain::entities::ActivityIndex index { std::move(*activitiesOpt) };
 
     // Validate có đủ activities cho mỗi category
-    if (!validateActivitiesAvailable(activities)) {
+    if (!validateActivitiesAvailable(index)) {
+        return std::nullopt;
+    }
+
+    // Cho strategy precompute tables một lần cho catalog này
+    randomStrategy_->prepare(index);
+    statistics.setCategories(index.getCategories());
+
+    if (residentMode_) {
+        residentCatalog_ = index;
+    }
+    return index;
+}
+
+bool ActivityAssignmentService::assignRange(
+    const domain::entities::ActivityIndex& index,
+    std::size_t firstStudent,
+    AssignmentTable& results,
+    std::vector<WorkerStats>& workerStats,
+    RunStatistics& statistics,
+    std::pmr::memory_resource* scratch) const
+{
+    PhaseTimer assignTimer { statistics, RunPhase::Assign };
+    const auto categories = index.getCategories();
+    const std::size_t categoryCount = categories.size();
+    const std::size_t studentCount = results.size();
+    const std::size_t rosterSize = firstStudent + studentCount;
+    const std::size_t blockCount = (studentCount + PARALLEL_BLOCK_SIZE - 1) / PARALLEL_BLOCK_SIZE;
+    const std::size_t workerCount = std::clamp<std::size_t>(threadCount_, 1, std::max<std::size_t>(blockCount, 1));
+    const std::uint64_t seed = randomStrategy_->getSeed();
+    const KernelFunction kernel = specializedKernel_ ? selectKernel(*randomStrategy_, index) : nullptr;
+
+    // Stats được cộng dồn qua các lần gọi (streaming chunks)
+    if (threadCount_ > 0 && workerStats.size() < workerCount) {
+        const std::size_t previous = workerStats.size();
+        workerStats.resize(workerCount);
+        for (std::size_t worker = previous; worker < workerCount; ++worker) {
+            workerStats[worker].workerIndex = worker;
+        }
+    }
+
+    // Per-worker draw buffers (một column per category), reuse cho mỗi block. Allocate trên
+    // calling thread vì arena resources không thread-safe
+    const std::size_t drawsPerWorker = kernel != nullptr ? 0 : PARALLEL_BLOCK_SIZE * categoryCount;
+    std::pmr::vector<domain::entities::ActivityId> drawBuffer(workerCount * drawsPerWorker, scratch);
+
+    std::atomic<bool> failed { false };
+
+    auto work = [&](std::size_t worker) {
+        const auto start = std::chrono::steady_clock::now();
+        // Shard boundaries align theo blocks (firstStudent đã align theo strata)
+        auto shardBoundary = [&](std::size_t shard) {
+            const std::size_t split = studentCount * shard / workerCount;
+            return shard == workerCount ? studentCount : split - split % PARALLEL_BLOCK_SIZE;
+        };
+        const std::size_t begin = shardBoundary(worker);
+        const std::size_t end = shardBoundary(worker + 1);
+
+        const auto draws = std::span(drawBuffer).subspan(worker * drawsPerWorker, drawsPerWorker);
+
+        for (std::size_t blockBegin = begin; blockBegin < end && !failed.load(std::memory_order_relaxed);
+             blockBegin += PARALLEL_BLOCK_SIZE) {
+            const std::size_t blockSize = std::min(PARALLEL_BLOCK_SIZE, end - blockBegin);
+            const strategies::DrawContext context { seed, firstStudent + blockBegin, rosterSize };
+            const auto rowIds = results.activityIds().subspan(blockBegin * categoryCount, blockSize * categoryCount);
+
+            auto studentIndices = results.studentIndices().subspan(blockBegin, blockSize);
+            for (std::size_t k = 0; k < blockSize; ++k) {
+                studentIndices[k] = static_cast<std::uint32_t>(firstStudent + blockBegin + k);
+            }
+
+            // Specialized path ghi thẳng vào results, không qua draw buffer
+            if (kernel != nullptr) {
+                if (!kernel(*randomStrategy_, index, context, rowIds)) {
+                    failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                continue;
+            }
+
+            // Một virtual call per category per block: cost tuyến tính theo số categories
+            for (std::size_t c = 0; c < categoryCount; ++c) {
+                auto column = draws.subspan(c * blockSize, blockSize);
+                if (!randomStrategy_->selectActivitiesFor(index, categories[c], context, column)) {
+                    failed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            for (std::size_t k = 0; k < blockSize; ++k) {
+                for (std::size_t c = 0; c < categoryCount; ++c) {
+                    rowIds[k * categoryCount + c] = draws[c * blockSize + k];
+                }
+            }
+        }
+
+        // Sequential mode (threadCount_ == 0) không report worker stats
+        if (threadCount_ > 0) {
+            workerStats[worker].studentCount += end - begin;
+            workerStats[worker].elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start);
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(workerCount - 1);
+        for (std::size_t worker = 1; worker < workerCount; ++worker) {
+            workers.emplace_back(work, worker);
+        }
+        // Calling thread xử lý shard đầu tiên
+        work(0);
+    }
+
+    if (failed.load()) {
+        return false;
+    }
+
+    // Mỗi student một draw per category
+    if constexpr (STATS_ENABLED) {
+        for (auto& draws : statistics.drawsPerCategory) {
+            draws += studentCount;
+        }
+    }
+    return true;
+}
+
+ActivityAssignmentService::KernelFunction
+ActivityAssignmentService::selectKernel(
+    const strategies::IRandomSelectionStrategy& strategy,
+    const domain::entities::ActivityIndex& index) noexcept
+{
+    // Kernel được instantiate cho built-in category set; catalogs khác dùng dynamic path
+    if (!std::ranges::equal(index.getCategories(), domain::entities::BUILTIN_CATEGORIES)) {
+        return nullptr;
+    }
+
+    // Exact type match: subclass có thể override draws, nên phải đi qua virtual path
+    const auto& type = typeid(strategy);
+    if (type == typeid(strategies::StandardRandomStrategy)) {
+        return &runKernel<strategies::StandardRandomStrategy>;
+    }
+    if (type == typeid(strategies::WeightedRandomStrategy)) {
+        return &runKernel<strategies::WeightedRandomStrategy>;
+    }
+    if (type == typeid(strategies::BalancedRandomStrategy)) {
+        return &runKernel<strategies::BalancedRandomStrategy>;
+    }
+    return nullptr;
+}
+
+template <typename Strategy>
+bool ActivityAssignmentService::runKernel(
+    const strategies::IRandomSelectionStrategy& strategy,
+    const domain::entities::ActivityIndex& index,
+    const strategies::DrawContext& context,
+    std::span<domain::entities::ActivityId> activityIds)
+{
+    return strategies::runAssignmentKernel<domain::entities::BUILTIN_CATEGORIES>(
+        static_cast<const Strategy&>(strategy), index, context, activityIds);
+}
+
+// Sequential pass sau parallel draws: thứ tự roster quyết định ai giữ seat,
+// nên results vẫn bit-identical với mọi threadCount
+bool ActivityAssignmentService::applyCapacities(const domain::entities::ActivityIndex& catalog,
+    CapacityLedger& ledger, AssignmentTable& results, std::size_t studentCount, RunStatistics& statistics) const
+{
+    PhaseTimer capacityTimer { statistics, RunPhase::Capacity };
+    std::uint64_t redirects = 0;
+
+    // Row-major ids: thứ tự roster, trong mỗi student theo thứ tự categories
+    for (auto& id : results.activityIds()) {
+        auto seat = ledger.reserve(id);
+        if (!seat) {
+            // Category chỉ full được khi mọi activity của nó có seat limit
+            const auto category = catalog.getActivity(id).getCategory();
+            std::uint64_t seats = 0;
+            for (const auto activityId : catalog.idsFor(category)) {
+                seats += catalog.getActivity(activityId).getCapacity();
+            }
+            lastError_ = "Category " + domain::entities::Activity::categoryToString(category)
+                + " is full: " + std::to_string(seats) + " seats for " + std::to_string(studentCount) + " students";
+            return false;
+        }
+        redirects += *seat != id;
+        id = *seat;
+    }
+    statistics.capacityRedirects += redirects;
+    return true;
+}
+
+// Recompute assignment của một student mà không replay cả run
+std::optional<std::vector<domain::entities::ActivityId>>
+ActivityAssignmentService::recomputeAssignment(
+    const domain::entities::ActivityIndex& catalog, std::size_t studentIndex, std::size_t rosterSize) const
+{
+    std::lock_guard lock(mutex_);
+    if (capacityConstrained_) {
         return std::nullopt;
     }
 
-    std::vector<AssignmentResult> results;
-    results.reserve(students.size());
+    const auto categories = catalog.getCategories();
+    std::vector<domain::entities::ActivityId> activityIds(categories.size());
+    const strategies::DrawContext context { randomStrategy_->getSeed(), studentIndex, rosterSize };
 
-    // Process each student
-    for (const auto& student : students) {
-        auto assignmentOpt = assignActivitiesToStudent(student, activities);
-        if (!assignmentOpt) {
+    for (std::size_t c = 0; c < categories.size(); ++c) {
+        if (!randomStrategy_->selectActivitiesFor(
+                catalog, categories[c], context, std::span(activityIds).subspan(c, 1))) {
             return std::nullopt;
         }
-        results.push_back(std::move(*assignmentOpt));
     }
 
-    return results;
+    return activityIds;
 }
 
 // Method để change strategy at runtime (Strategy Pattern)
 void ActivityAssignmentService::setRandomStrategy(
     std::unique_ptr<strategies::IRandomSelectionStrategy> strategy)
 {
+    std::lock_guard lock(mutex_);
     randomStrategy_ = std::move(strategy);
+
+    // Strategy mới chưa prepare() với resident catalog
+    residentCatalog_.reset();
+}
+
+std::string ActivityAssignmentService::getLastError() const
+{
+    std::lock_guard lock(mutex_);
+    return lastError_;
 }
 
 // Get current strategy info
@@ -76,39 +659,109 @@ std::string ActivityAssignmentService::getCurrentStrategyInfo() const noexcept
     return randomStrategy_ ? randomStrategy_->getStrategyName() : "No strategy set";
 }
 
-// Helper method để validate activities sử dụng C++20 ranges
-bool ActivityAssignmentService::validateActivitiesAvailable(
-    const std::vector<domain::entities::Activity>& activities) const noexcept
+// Get current seed
+std::uint64_t ActivityAssignmentService::getCurrentSeed() const noexcept
 {
-    // Sử dụng ranges::all_of (C++20) để check tất cả categories có activities
-    return std::ranges::all_of(REQUIRED_CATEGORIES, [&activities](auto category) {
-        return std::ranges::any_of(activities, [category](const auto& activity) {
-            return activity.getCategory() == category;
-        });
-    });
+    return randomStrategy_ ? randomStrategy_->getSeed() : 0;
 }
 
-// Helper method to assign activities to a single student
-std::optional<ActivityAssignmentService::AssignmentResult>
-ActivityAssignmentService::assignActivitiesToStudent(
-    const domain::entities::Student& student,
-    const std::vector<domain::entities::Activity>& activities) const
+void ActivityAssignmentService::setThreadCount(std::size_t threadCount) noexcept
 {
-    AssignmentResult result{student};
+    threadCount_ = threadCount;
+}
 
-    // Assign one activity per category
-    for (size_t i = 0; i < REQUIRED_CATEGORIES.size(); ++i) {
-        auto activityOpt = randomStrategy_->selectRandomActivity(
-            activities, REQUIRED_CATEGORIES[i]);
+void ActivityAssignmentService::setCapacityConstrained(bool enabled) noexcept
+{
+    capacityConstrained_ = enabled;
+}
 
-        if (!activityOpt) {
-            return std::nullopt;
-        }
+bool ActivityAssignmentService::isCapacityConstrained() const noexcept
+{
+    return capacityConstrained_;
+}
+
+void ActivityAssignmentService::setSpecializedKernel(bool enabled) noexcept
+{
+    specializedKernel_ = enabled;
+}
+
+bool ActivityAssignmentService::isSpecializedKernel() const noexcept
+{
+    return specializedKernel_;
+}
+
+void ActivityAssignmentService::setMemoryResource(std::pmr::memory_resource* resource) noexcept
+{
+    memoryResource_ = resource;
+}
+
+void ActivityAssignmentService::setRunArena(bool enabled) noexcept
+{
+    runArena_ = enabled;
+}
+
+bool ActivityAssignmentService::isRunArena() const noexcept
+{
+    return runArena_;
+}
 
-        result.activities[i] = std::move(*activityOpt);
+std::shared_ptr<std::pmr::monotonic_buffer_resource> ActivityAssignmentService::makeArena() const
+{
+    if (!runArena_) {
+        return nullptr;
     }
+    return std::make_shared<std::pmr::monotonic_buffer_resource>(memoryResource_);
+}
+
+std::pmr::memory_resource* ActivityAssignmentService::resourceOf(
+    const std::shared_ptr<std::pmr::monotonic_buffer_resource>& arena) const noexcept
+{
+    return arena ? arena.get() : memoryResource_;
+}
+
+void ActivityAssignmentService::setResidentMode(bool enabled)
+{
+    std::lock_guard lock(mutex_);
+    residentMode_ = enabled;
+    if (!enabled) {
+        residentCatalog_.reset();
+    }
+}
 
-    return result;
+bool ActivityAssignmentService::preloadRoster() const
+{
+    std::lock_guard lock(mutex_);
+    return studentRepo_->loadSharedStudents(memoryResource_) != nullptr;
+}
+
+bool ActivityAssignmentService::preloadCatalog() const
+{
+    std::lock_guard lock(mutex_);
+    RunStatistics statistics;
+    return loadCatalog(statistics).has_value();
+}
+
+// Helper method để validate activities: categories đến từ catalog nên mỗi category
+// có ít nhất một activity; catalog chỉ cần có ít nhất một category
+bool ActivityAssignmentService::validateActivitiesAvailable(
+    const domain::entities::ActivityIndex& index) const
+{
+    std::string missing;
+    for (const auto category : domain::entities::Activity::requiredCategories()) {
+        if (!index.hasCategory(category)) {
+            missing.append(missing.empty() ? "" : ", ").append(domain::entities::Activity::categoryToString(category));
+        }
+    }
+    if (!missing.empty()) {
+        lastError_ = "No activities for required categories: " + missing;
+        return false;
+    }
+    // --categories có thể không gồm built-ins: catalog vẫn phải có ít nhất một category
+    if (index.categoryCount() == 0) {
+        lastError_ = "Catalog has no activities";
+        return false;
+    }
+    return true;
 }
 
 } // namespace application::services
@@ -1,31 +1,61 @@
 #pragma once
 
 #include "../../application/strategies/IRandomSelectionStrategy.h"
+#include "AssignmentTable.h"
+#include "CapacityLedger.h"
+#include "RunStatistics.h"
 #include "../../domain/entities/Activity.h"
+#include "../../domain/entities/ActivityIndex.h"
 #include "../../domain/entities/Student.h"
 #include "../../domain/repositories/IActivityRepository.h"
+#include "../../domain/repositories/IAssignmentStateRepository.h"
 #include "../../domain/repositories/IStudentRepository.h"
-#include <array>
+#include <chrono>
+#include <cstdint>
 #include <expected>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
 #include <vector>
 #include <string>
 
 namespace application::services {
 
-// Service class theo Clean Architecture
+// Service class theo Clean Architecture.
+// Các assign/preload methods thread-safe (serialize bằng internal mutex)
 class ActivityAssignmentService {
 private:
     std::unique_ptr<domain::repositories::IStudentRepository> studentRepo_;
     std::unique_ptr<domain::repositories::IActivityRepository> activityRepo_;
     std::unique_ptr<strategies::IRandomSelectionStrategy> randomStrategy_;
 
-    // std::array (C++11) để store required categories
-    static constexpr std::array<domain::entities::ActivityCategory, 3> REQUIRED_CATEGORIES = {
-        domain::entities::ActivityCategory::Class,
-        domain::entities::ActivityCategory::Union,
-        domain::entities::ActivityCategory::School
-    };
+    // 0 = sequential trên calling thread; >= 1 = số parallel workers
+    std::size_t threadCount_ = 0;
+
+    // Enforce activity capacities từ catalog (không overbook)
+    bool capacityConstrained_ = false;
+
+    // Built-in strategies chạy compile-time kernel thay vì virtual per-category calls
+    bool specializedKernel_ = true;
+
+    // Upstream cho per-run allocations (roster, results, scratch buffers)
+    std::pmr::memory_resource* memoryResource_ = std::pmr::get_default_resource();
+
+    // Per-run allocations bump từ monotonic arena trên memoryResource_ thay vì allocate thẳng
+    bool runArena_ = true;
+
+    // Serialize các runs: strategies và resident cache không thread-safe.
+    // Setters là configuration, gọi trước khi share service giữa threads
+    mutable std::mutex mutex_;
+
+    // Resident mode (daemon): catalog index đã build + prepare được giữ giữa các runs
+    bool residentMode_ = false;
+    mutable std::optional<domain::entities::ActivityIndex> residentCatalog_;
+
+    // Error message của lần load catalog gần nhất thất bại; rỗng sau một lần load thành công
+    mutable std::string lastError_;
 
 public:
     // Constructor với dependency injection
@@ -34,35 +64,199 @@ public:
         std::unique_ptr<domain::repositories::IActivityRepository> activityRepo,
         std::unique_ptr<strategies::IRandomSelectionStrategy> randomStrategy);
 
-    // Structured binding return type (C++17)
-    struct AssignmentResult {
-        domain::entities::Student student;
-        std::array<domain::entities::Activity, 3> activities;
+    // Compact results: student index trong roster + một activity id per category của
+    // catalog (catalog.getCategories()), lưu dạng structure-of-arrays
+    using AssignmentResult = services::AssignmentResult;
+    using AssignmentTable = services::AssignmentTable;
+    using AssignmentRows = services::AssignmentRows;
+
+    // Throughput của một worker trong parallel run
+    struct WorkerStats {
+        std::size_t workerIndex;
+        std::size_t studentCount;
+        std::chrono::nanoseconds elapsed;
+
+        [[nodiscard]] double studentsPerSecond() const noexcept;
+    };
+
+    // Roster và catalog được share bởi tất cả results; names chỉ resolve lúc output
+    struct AssignmentSet {
+        // Run arena của students và results (nullptr khi tắt run arena), release một lần khi
+        // set bị destroy. Khai báo đầu tiên để sống lâu hơn các containers; const nên set chỉ
+        // move-constructible: move-assign sẽ copy rows vào arena cũ đang bị release
+        const std::shared_ptr<std::pmr::memory_resource> memory;
+        // Roster read-only: nằm trong arena, hoặc là roster của repository cache (daemon)
+        // được chia sẻ giữa các runs không copy
+        domain::repositories::IStudentRepository::SharedStudentList students;
+        domain::entities::ActivityIndex catalog;
+        AssignmentTable results;
+        std::vector<WorkerStats> workerStats; // Chỉ có trong parallel mode
+        RunStatistics statistics;             // Output phase do caller ghi thêm
+
+        [[nodiscard]] const domain::entities::Student& studentOf(
+            const AssignmentResult& result) const noexcept;
+        [[nodiscard]] const domain::entities::Activity& activityOf(
+            domain::entities::ActivityId id) const noexcept;
+    };
+
+    // Một chunk results trong streaming mode; students[k] ứng với results[k].
+    // Spans chỉ valid trong consumer callback
+    struct AssignmentChunk {
+        std::span<const domain::entities::Student> students;
+        const domain::entities::ActivityIndex& catalog;
+        AssignmentRows results;
+    };
+
+    // Consumer return false để dừng streaming sớm
+    using ChunkConsumer = std::function<bool(const AssignmentChunk&)>;
 
-        // Constructor với Student
-        AssignmentResult(domain::entities::Student s);
+    struct StreamSummary {
+        std::size_t studentCount;
+        std::vector<WorkerStats> workerStats; // Chỉ có trong parallel mode
+        RunStatistics statistics;             // Output = thời gian trong consumer
     };
 
-    // Main business logic method
-    [[nodiscard]] std::optional<std::vector<AssignmentResult>>
+    // Delta của incremental run so với state trước
+    struct IncrementalStats {
+        std::size_t keptCount;     // Students giữ nguyên assignment
+        std::size_t assignedCount; // Students mới, hoặc có activity không còn trong catalog
+        std::size_t removedCount;  // Students trong state nhưng không còn trong roster
+    };
+
+    struct IncrementalAssignment {
+        AssignmentSet assignment;
+        domain::repositories::AssignmentState state; // State mới để persist
+        IncrementalStats stats;
+    };
+
+    // Main business logic method: mỗi student một activity cho mỗi category có trong catalog
+    [[nodiscard]] std::optional<AssignmentSet>
     assignActivitiesToStudents() const;
 
+    // Incremental mode: students có trong previous state giữ assignment cũ (remap theo
+    // activity name sang catalog hiện tại), chỉ students mới hoặc có activity đã bị xoá
+    // được draw; students không còn trong roster bị drop khỏi state mới.
+    // Draws chỉ chạy trên delta; phần còn lại là lookups trên sorted state
+    [[nodiscard]] std::optional<IncrementalAssignment>
+    assignActivitiesIncrementally(const domain::repositories::AssignmentState& previous) const;
+
+    // Streaming mode: roster được đọc theo chunks tối đa chunkSize students, mỗi chunk
+    // được assign và đưa cho consumer trước khi đọc chunk tiếp theo (memory bounded).
+    // chunkSize được round lên bội số của DRAW_STRATUM_SIZE.
+    // Cùng seed cho cùng results như assignActivitiesToStudents()
+    [[nodiscard]] std::optional<StreamSummary>
+    assignActivitiesStreaming(std::size_t chunkSize, const ChunkConsumer& consumer) const;
+
     // Method để change strategy at runtime (Strategy Pattern)
     void setRandomStrategy(std::unique_ptr<strategies::IRandomSelectionStrategy> strategy);
 
     // Get current strategy info
     [[nodiscard]] std::string getCurrentStrategyInfo() const noexcept;
 
+    // Seed của current strategy, để reproduce run
+    [[nodiscard]] std::uint64_t getCurrentSeed() const noexcept;
+
+    // Lý do catalog của run (hoặc preloadCatalog()) gần nhất không load được, ví dụ
+    // "Invalid category in line 7: Robtics"; rỗng nếu không có
+    [[nodiscard]] std::string getLastError() const;
+
+    // Bật parallel mode với threadCount workers (0 = sequential).
+    // Draws là counter-based theo (strategy seed, student index, category),
+    // nên results bit-identical với mọi threadCount
+    void setThreadCount(std::size_t threadCount) noexcept;
+
+    // Bật capacity-aware mode: strategy vẫn draw như bình thường, sau đó seats được
+    // reserve theo thứ tự roster; student draw trúng activity đã full được chuyển sang
+    // activity còn nhiều seats nhất cùng category. Run fail nếu một category hết seats
+    void setCapacityConstrained(bool enabled) noexcept;
+
+    [[nodiscard]] bool isCapacityConstrained() const noexcept;
+
+    // Bật/tắt compile-time kernel (AssignmentKernel.h) cho built-in strategies khi catalog
+    // có đúng BUILTIN_CATEGORIES: categories unrolled và sampler devirtualized per student.
+    // Strategies và category sets khác đi qua virtual selectActivitiesFor() per category;
+    // results giống nhau ở cả hai paths
+    void setSpecializedKernel(bool enabled) noexcept;
+
+    [[nodiscard]] bool isSpecializedKernel() const noexcept;
+
+    // Upstream memory resource cho per-run allocations; phải outlive mọi AssignmentSet
+    void setMemoryResource(std::pmr::memory_resource* resource) noexcept;
+
+    // Bật/tắt run-scoped arena: roster và results của một run bump-allocate từ một
+    // std::pmr::monotonic_buffer_resource do AssignmentSet giữ, scratch buffers từ arena
+    // riêng release khi run (hoặc mỗi chunk trong streaming mode) xong. Tắt thì allocate
+    // thẳng từ memory resource, để so sánh; results giống nhau ở cả hai modes
+    void setRunArena(bool enabled) noexcept;
+
+    [[nodiscard]] bool isRunArena() const noexcept;
+
+    // Bật resident mode cho long-running process: catalog index (và strategy tables)
+    // chỉ được rebuild khi activities load được khác với lần trước. Roster nên được
+    // cache bởi repository decorator (createCachingStudentRepository)
+    void setResidentMode(bool enabled);
+
+    // Load trước roster / catalog để run tiếp theo không tốn load và index time
+    [[nodiscard]] bool preloadRoster() const;
+    [[nodiscard]] bool preloadCatalog() const;
+
+    // Recompute assignment của một student từ seed, không replay cả run.
+    // Catalog và rosterSize phải là của run gốc và strategy đã prepare() với catalog.
+    // Không hỗ trợ trong capacity-aware mode (result phụ thuộc các students trước).
+    // ids[c] là activity của catalog.getCategories()[c]
+    [[nodiscard]] std::optional<std::vector<domain::entities::ActivityId>> recomputeAssignment(
+        const domain::entities::ActivityIndex& catalog, std::size_t studentIndex, std::size_t rosterSize) const;
+
 private:
-    // Helper method để validate activities
+    // Monotonic arena trên memoryResource_, nullptr khi tắt run arena
+    [[nodiscard]] std::shared_ptr<std::pmr::monotonic_buffer_resource> makeArena() const;
+
+    // Resource cho allocations trong arena (hoặc memoryResource_ nếu không có arena)
+    [[nodiscard]] std::pmr::memory_resource* resourceOf(
+        const std::shared_ptr<std::pmr::monotonic_buffer_resource>& arena) const noexcept;
+
+    // Kernel cho một block: fill row-major activity ids của rows theo context
+    using KernelFunction = bool (*)(
+        const strategies::IRandomSelectionStrategy& strategy,
+        const domain::entities::ActivityIndex& index,
+        const strategies::DrawContext& context,
+        std::span<domain::entities::ActivityId> activityIds);
+
+    // Specialized kernel cho dynamic type của strategy và category set của index;
+    // nullptr nếu không phải built-in strategy hoặc catalog khác BUILTIN_CATEGORIES
+    [[nodiscard]] static KernelFunction selectKernel(
+        const strategies::IRandomSelectionStrategy& strategy,
+        const domain::entities::ActivityIndex& index) noexcept;
+
+    template <typename Strategy>
+    [[nodiscard]] static bool runKernel(
+        const strategies::IRandomSelectionStrategy& strategy,
+        const domain::entities::ActivityIndex& index,
+        const strategies::DrawContext& context,
+        std::span<domain::entities::ActivityId> activityIds);
+
+    // Validate mỗi required category có activities; set lastError_ với các categories thiếu
     [[nodiscard]] bool validateActivitiesAvailable(
-        const std::vector<domain::entities::Activity>& activities) const noexcept;
+        const domain::entities::ActivityIndex& index) const;
+
+    // Load activities, build index, validate và prepare strategy
+    [[nodiscard]] std::optional<domain::entities::ActivityIndex> loadCatalog(RunStatistics& statistics) const;
+
+    // Assign students [firstStudent, firstStudent + results.size()): chia thành
+    // contiguous shards trên workers, counter-based draws. results.categoryCount()
+    // phải bằng index.categoryCount(). Draw buffers allocate từ scratch trước khi spawn workers
+    [[nodiscard]] bool assignRange(
+        const domain::entities::ActivityIndex& index,
+        std::size_t firstStudent,
+        AssignmentTable& results,
+        std::vector<WorkerStats>& workerStats,
+        RunStatistics& statistics,
+        std::pmr::memory_resource* scratch) const;
 
-    // Helper method to assign activities to a single student
-    [[nodiscard]] std::optional<AssignmentResult>
-    assignActivitiesToStudent(
-        const domain::entities::Student& student,
-        const std::vector<domain::entities::Activity>& activities) const;
+    // Reserve seats cho results theo thứ tự, thay draws trúng activity đã full. Khi cả
+    // category đã full, set lastError_ với tổng seats và studentCount (students tới hiện tại)
+    [[nodiscard]] bool applyCapacities(const domain::entities::ActivityIndex& catalog,
+        CapacityLedger& ledger, AssignmentTable& results, std::size_t studentCount, RunStatistics& statistics) const;
 };
 
 } // namespace application::services
@@ -0,0 +1,50 @@
+#include "AssignmentLookup.h"
+#include <algorithm>
+#include <numeric>
+
+namespace application::services {
+
+AssignmentLookup::AssignmentLookup(AssignmentSet assignment)
+    : assignment_(std::move(assignment))
+{
+    const auto& students = *assignment_.students;
+
+    // Sort một permutation theo packed id; roster trùng id thì giữ lần xuất hiện đầu
+    std::vector<std::uint32_t> order(assignment_.results.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::stable_sort(order, {}, [&](std::uint32_t k) {
+        return students[assignment_.results[k].studentIndex].getPackedId();
+    });
+
+    sortedIds_.reserve(order.size());
+    resultIndices_.reserve(order.size());
+    for (auto k : order) {
+        const auto id = students[assignment_.results[k].studentIndex].getPackedId();
+        if (sortedIds_.empty() || sortedIds_.back() != id) {
+            sortedIds_.push_back(id);
+            resultIndices_.push_back(k);
+        }
+    }
+}
+
+std::optional<AssignmentLookup::AssignmentResult> AssignmentLookup::find(
+    domain::entities::Student::PackedId id) const noexcept
+{
+    auto it = std::ranges::lower_bound(sortedIds_, id);
+    if (it == sortedIds_.end() || *it != id) {
+        return std::nullopt;
+    }
+    return assignment_.results[resultIndices_[static_cast<std::size_t>(it - sortedIds_.begin())]];
+}
+
+const AssignmentLookup::AssignmentSet& AssignmentLookup::getAssignment() const noexcept
+{
+    return assignment_;
+}
+
+std::size_t AssignmentLookup::size() const noexcept
+{
+    return sortedIds_.size();
+}
+
+} // namespace application::services
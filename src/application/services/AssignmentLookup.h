@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ActivityAssignmentService.h"
+#include <optional>
+#include <vector>
+
+namespace application::services {
+
+// Immutable point-lookup index trên một AssignmentSet: packed student id → result.
+// Không có mutable state nên share được giữa nhiều threads sau khi build
+class AssignmentLookup {
+public:
+    using AssignmentSet = ActivityAssignmentService::AssignmentSet;
+    using AssignmentResult = ActivityAssignmentService::AssignmentResult;
+
+private:
+    AssignmentSet assignment_;
+
+    // Packed ids sorted ascending; resultIndices_[k] là result của sortedIds_[k]
+    std::vector<domain::entities::Student::PackedId> sortedIds_;
+    std::vector<std::uint32_t> resultIndices_;
+
+public:
+    explicit AssignmentLookup(AssignmentSet assignment);
+
+    // O(log N); nullopt nếu student không có trong roster. View valid trong lifetime của lookup
+    [[nodiscard]] std::optional<AssignmentResult> find(domain::entities::Student::PackedId id) const noexcept;
+
+    [[nodiscard]] const AssignmentSet& getAssignment() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+};
+
+} // namespace application::services
@@ -0,0 +1,64 @@
+#include "AssignmentTable.h"
+
+namespace application::services {
+
+AssignmentRows::AssignmentRows(const AssignmentTable& table) noexcept
+    : studentIndices_(table.studentIndices())
+    , activityIds_(table.activityIds())
+    , categoryCount_(table.categoryCount())
+{
+}
+
+AssignmentRows::AssignmentRows(std::span<const std::uint32_t> studentIndices,
+    std::span<const domain::entities::ActivityId> activityIds,
+    std::size_t categoryCount) noexcept
+    : studentIndices_(studentIndices)
+    , activityIds_(activityIds)
+    , categoryCount_(categoryCount)
+{
+}
+
+AssignmentResult AssignmentRows::operator[](std::size_t row) const noexcept
+{
+    return { studentIndices_[row], activityIds_.subspan(row * categoryCount_, categoryCount_) };
+}
+
+AssignmentRows AssignmentRows::subspan(std::size_t offset, std::size_t count) const noexcept
+{
+    return { studentIndices_.subspan(offset, count),
+        activityIds_.subspan(offset * categoryCount_, count * categoryCount_),
+        categoryCount_ };
+}
+
+AssignmentTable::AssignmentTable(std::size_t categoryCount, std::size_t rowCount,
+    std::pmr::memory_resource* resource)
+    : categoryCount_(categoryCount)
+    , studentIndices_(resource)
+    , activityIds_(resource)
+{
+    resize(rowCount);
+}
+
+void AssignmentTable::resize(std::size_t rowCount)
+{
+    studentIndices_.resize(rowCount);
+    activityIds_.resize(rowCount * categoryCount_);
+}
+
+void AssignmentTable::reserve(std::size_t rowCount)
+{
+    studentIndices_.reserve(rowCount);
+    activityIds_.reserve(rowCount * categoryCount_);
+}
+
+AssignmentResult AssignmentTable::operator[](std::size_t row) const noexcept
+{
+    return AssignmentRows(*this)[row];
+}
+
+std::span<domain::entities::ActivityId> AssignmentTable::activityIdsOf(std::size_t row) noexcept
+{
+    return std::span(activityIds_).subspan(row * categoryCount_, categoryCount_);
+}
+
+} // namespace application::services
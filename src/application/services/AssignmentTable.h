@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../../domain/entities/ActivityIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace application::services {
+
+// Một row của assignment results: student index trong roster + activityIds[c] là
+// activity của category catalog.getCategories()[c]. View, valid trong lifetime của table
+struct AssignmentResult {
+    std::uint32_t studentIndex;
+    std::span<const domain::entities::ActivityId> activityIds;
+};
+
+class AssignmentTable;
+
+// Non-owning view trên contiguous rows của một AssignmentTable (tương tự std::span)
+class AssignmentRows {
+private:
+    std::span<const std::uint32_t> studentIndices_;
+    std::span<const domain::entities::ActivityId> activityIds_;
+    std::size_t categoryCount_ = 0;
+
+public:
+    AssignmentRows() = default;
+    // Implicit, như std::vector → std::span
+    AssignmentRows(const AssignmentTable& table) noexcept;
+    AssignmentRows(std::span<const std::uint32_t> studentIndices,
+        std::span<const domain::entities::ActivityId> activityIds,
+        std::size_t categoryCount) noexcept;
+
+    [[nodiscard]] AssignmentResult operator[](std::size_t row) const noexcept;
+    [[nodiscard]] AssignmentRows subspan(std::size_t offset, std::size_t count) const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return studentIndices_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return studentIndices_.empty(); }
+    [[nodiscard]] std::size_t categoryCount() const noexcept { return categoryCount_; }
+
+    // Row-major ids: row k chiếm [k * categoryCount(), (k + 1) * categoryCount())
+    [[nodiscard]] std::span<const std::uint32_t> studentIndices() const noexcept { return studentIndices_; }
+    [[nodiscard]] std::span<const domain::entities::ActivityId> activityIds() const noexcept { return activityIds_; }
+};
+
+// Assignment results dạng structure-of-arrays: một array student indices và một
+// row-major array activity ids với categoryCount() ids per row. Số categories là
+// runtime (theo catalog), nên row không có fixed-size array.
+// Arrays allocate từ memory resource của table (vd. run arena), resource phải outlive table
+class AssignmentTable {
+private:
+    std::size_t categoryCount_ = 0;
+    std::pmr::vector<std::uint32_t> studentIndices_;
+    std::pmr::vector<domain::entities::ActivityId> activityIds_;
+
+public:
+    AssignmentTable() = default;
+    explicit AssignmentTable(std::size_t categoryCount, std::size_t rowCount = 0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    void resize(std::size_t rowCount);
+    void reserve(std::size_t rowCount);
+
+    [[nodiscard]] AssignmentResult operator[](std::size_t row) const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return studentIndices_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return studentIndices_.empty(); }
+    [[nodiscard]] std::size_t categoryCount() const noexcept { return categoryCount_; }
+
+    [[nodiscard]] std::span<std::uint32_t> studentIndices() noexcept { return studentIndices_; }
+    [[nodiscard]] std::span<const std::uint32_t> studentIndices() const noexcept { return studentIndices_; }
+    [[nodiscard]] std::span<domain::entities::ActivityId> activityIds() noexcept { return activityIds_; }
+    [[nodiscard]] std::span<const domain::entities::ActivityId> activityIds() const noexcept { return activityIds_; }
+
+    // Mutable ids của một row
+    [[nodiscard]] std::span<domain::entities::ActivityId> activityIdsOf(std::size_t row) noexcept;
+};
+
+} // namespace application::services
@@ -0,0 +1,76 @@
+#include "CapacityLedger.h"
+#include <algorithm>
+
+namespace application::services {
+
+CapacityLedger::CapacityLedger(const domain::entities::ActivityIndex& catalog)
+    : catalog_(&catalog)
+{
+    const auto activities = catalog.getActivities();
+    remaining_.reserve(activities.size());
+    for (const auto& activity : activities) {
+        remaining_.push_back(activity.getCapacity());
+    }
+
+    const auto categories = catalog.getCategories();
+    heaps_.resize(categories.size());
+    for (std::size_t pool = 0; pool < categories.size(); ++pool) {
+        auto& heap = heaps_[pool];
+        for (auto id : catalog.idsFor(categories[pool])) {
+            if (remaining_[id] > 0) {
+                heap.emplace_back(remaining_[id], id);
+            }
+        }
+        std::ranges::make_heap(heap);
+    }
+}
+
+std::optional<domain::entities::ActivityId> CapacityLedger::reserve(
+    domain::entities::ActivityId preferred)
+{
+    if (remaining_[preferred] > 0) {
+        take(preferred);
+        return preferred;
+    }
+
+    // Fallback: refresh stale entries cho tới khi top phản ánh đúng remaining seats
+    auto& heap = heaps_[catalog_->poolOf(catalog_->getActivity(preferred).getCategory())];
+    while (!heap.empty()) {
+        const auto [seats, id] = heap.front();
+        if (seats == remaining_[id]) {
+            take(id);
+            return id;
+        }
+
+        std::ranges::pop_heap(heap);
+        heap.pop_back();
+        if (remaining_[id] > 0) {
+            heap.emplace_back(remaining_[id], id);
+            std::ranges::push_heap(heap);
+        }
+    }
+
+    return std::nullopt;
+}
+
+void CapacityLedger::consume(domain::entities::ActivityId id) noexcept
+{
+    if (remaining_[id] > 0) {
+        take(id);
+    }
+}
+
+std::uint32_t CapacityLedger::getRemaining(domain::entities::ActivityId id) const noexcept
+{
+    return remaining_[id];
+}
+
+// Unlimited activities không bao giờ bị trừ seats
+void CapacityLedger::take(domain::entities::ActivityId id) noexcept
+{
+    if (catalog_->getActivity(id).hasCapacityLimit()) {
+        --remaining_[id];
+    }
+}
+
+} // namespace application::services
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../../domain/entities/ActivityIndex.h"
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace application::services {
+
+// Remaining seats của mỗi activity trong một assignment run.
+// Khi activity được draw đã full, seat được chuyển sang activity còn nhiều
+// seats nhất cùng category qua per-category max-heap (lazy update), nên mỗi
+// reservation là amortized O(log k) và không bao giờ overbook.
+class CapacityLedger {
+private:
+    // (remaining seats, activity id); entry có thể stale cho tới khi lên top
+    using HeapEntry = std::pair<std::uint32_t, domain::entities::ActivityId>;
+
+    const domain::entities::ActivityIndex* catalog_;
+    std::vector<std::uint32_t> remaining_;
+    std::vector<std::vector<HeapEntry>> heaps_; // Một heap per pool của catalog
+
+public:
+    explicit CapacityLedger(const domain::entities::ActivityIndex& catalog);
+
+    // Reserve một seat: preferred nếu còn chỗ, không thì activity còn nhiều seats
+    // nhất cùng category. nullopt khi cả category đã full
+    [[nodiscard]] std::optional<domain::entities::ActivityId> reserve(
+        domain::entities::ActivityId preferred);
+
+    // Count một seat đã được assign trước đó (không đổi activity, kể cả khi đã full)
+    void consume(domain::entities::ActivityId id) noexcept;
+
+    [[nodiscard]] std::uint32_t getRemaining(domain::entities::ActivityId id) const noexcept;
+
+private:
+    void take(domain::entities::ActivityId id) noexcept;
+};
+
+} // namespace application::services
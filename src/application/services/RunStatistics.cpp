@@ -0,0 +1,85 @@
+#include "RunStatistics.h"
+#include <numeric>
+
+namespace application::services {
+
+namespace detail {
+std::atomic<std::uint64_t> bytesReadCounter { 0 };
+std::atomic<std::uint64_t> bytesWrittenCounter { 0 };
+std::atomic<bool> allocationCountingEnabled { false };
+std::atomic<std::uint64_t> allocationCounter { 0 };
+std::atomic<std::uint64_t> allocatedBytesCounter { 0 };
+} // namespace detail
+
+std::string_view phaseName(RunPhase phase) noexcept
+{
+    switch (phase) {
+    case RunPhase::Load:
+        return "load";
+    case RunPhase::Validate:
+        return "validate";
+    case RunPhase::Assign:
+        return "assign";
+    case RunPhase::Capacity:
+        return "capacity";
+    case RunPhase::Output:
+        return "output";
+    }
+    return "unknown";
+}
+
+CounterSnapshot CounterSnapshot::operator-(const CounterSnapshot& earlier) const noexcept
+{
+    return {
+        .allocationCount = allocationCount - earlier.allocationCount,
+        .allocatedBytes = allocatedBytes - earlier.allocatedBytes,
+        .bytesRead = bytesRead - earlier.bytesRead,
+        .bytesWritten = bytesWritten - earlier.bytesWritten
+    };
+}
+
+CounterSnapshot snapshotCounters() noexcept
+{
+    return {
+        .allocationCount = detail::allocationCounter.load(std::memory_order_relaxed),
+        .allocatedBytes = detail::allocatedBytesCounter.load(std::memory_order_relaxed),
+        .bytesRead = detail::bytesReadCounter.load(std::memory_order_relaxed),
+        .bytesWritten = detail::bytesWrittenCounter.load(std::memory_order_relaxed)
+    };
+}
+
+void RunStatistics::addPhaseTime(RunPhase phase, std::chrono::nanoseconds elapsed) noexcept
+{
+    phaseTimes[static_cast<std::size_t>(phase)] += elapsed;
+}
+
+std::chrono::nanoseconds RunStatistics::getPhaseTime(RunPhase phase) const noexcept
+{
+    return phaseTimes[static_cast<std::size_t>(phase)];
+}
+
+std::chrono::nanoseconds RunStatistics::getTotalTime() const noexcept
+{
+    return std::accumulate(phaseTimes.begin(), phaseTimes.end(), std::chrono::nanoseconds {});
+}
+
+void RunStatistics::setCategories(std::span<const domain::entities::ActivityCategory> catalogCategories)
+{
+    categories.assign(catalogCategories.begin(), catalogCategories.end());
+    drawsPerCategory.assign(categories.size(), 0);
+}
+
+void enableAllocationCounting() noexcept
+{
+    if constexpr (STATS_ENABLED) {
+        detail::allocationCountingEnabled.store(true, std::memory_order_relaxed);
+    }
+}
+
+double RunStatistics::studentsPerSecond() const noexcept
+{
+    const auto seconds = std::chrono::duration<double>(getTotalTime()).count();
+    return seconds > 0.0 ? static_cast<double>(studentCount) / seconds : 0.0;
+}
+
+} // namespace application::services
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "../../domain/entities/Activity.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Build với SAA_ENABLE_STATS=0 để instrumentation compile thành no-ops
+// (không clock reads, không counters, executable không thay global operator new)
+#ifndef SAA_ENABLE_STATS
+#define SAA_ENABLE_STATS 1
+#endif
+
+namespace application::services {
+
+inline constexpr bool STATS_ENABLED = SAA_ENABLE_STATS != 0;
+
+// Các phases của một run, theo thứ tự chạy
+enum class RunPhase {
+    Load,     // Đọc roster và catalog
+    Validate, // Build index, validate categories, prepare strategy
+    Assign,   // Draws
+    Capacity, // Seat reservation (capacity-aware mode)
+    Output    // Format và ghi results
+};
+
+inline constexpr std::size_t RUN_PHASE_COUNT = 5;
+
+[[nodiscard]] std::string_view phaseName(RunPhase phase) noexcept;
+
+// Process-wide counters: allocations (qua global operator new của executable, chỉ
+// đếm sau enableAllocationCounting()) và bytes I/O được report bởi repositories và writers
+struct CounterSnapshot {
+    std::uint64_t allocationCount = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t bytesRead = 0;
+    std::uint64_t bytesWritten = 0;
+
+    [[nodiscard]] CounterSnapshot operator-(const CounterSnapshot& earlier) const noexcept;
+};
+
+namespace detail {
+extern std::atomic<std::uint64_t> bytesReadCounter;
+extern std::atomic<std::uint64_t> bytesWrittenCounter;
+extern std::atomic<bool> allocationCountingEnabled;
+extern std::atomic<std::uint64_t> allocationCounter;
+extern std::atomic<std::uint64_t> allocatedBytesCounter;
+} // namespace detail
+
+[[nodiscard]] CounterSnapshot snapshotCounters() noexcept;
+
+// Bật allocation counters (--stats); tắt thì operator new chỉ tốn một relaxed load
+void enableAllocationCounting() noexcept;
+
+inline void recordAllocation(std::size_t bytes) noexcept
+{
+    if constexpr (STATS_ENABLED) {
+        if (detail::allocationCountingEnabled.load(std::memory_order_relaxed)) {
+            detail::allocationCounter.fetch_add(1, std::memory_order_relaxed);
+            detail::allocatedBytesCounter.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+}
+
+inline void recordBytesRead(std::uint64_t bytes) noexcept
+{
+    if constexpr (STATS_ENABLED) {
+        detail::bytesReadCounter.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+inline void recordBytesWritten(std::uint64_t bytes) noexcept
+{
+    if constexpr (STATS_ENABLED) {
+        detail::bytesWrittenCounter.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+// Timing và counters của một run (batch, streaming hoặc incremental)
+struct RunStatistics {
+    std::array<std::chrono::nanoseconds, RUN_PHASE_COUNT> phaseTimes {};
+    std::size_t studentCount = 0;
+    std::vector<domain::entities::ActivityCategory> categories; // Categories của catalog
+    std::vector<std::uint64_t> drawsPerCategory;                // drawsPerCategory[c] ứng với categories[c]
+    std::uint64_t capacityRedirects = 0; // Draws chuyển sang activity khác vì đã full
+    CounterSnapshot counters {};          // Delta trong suốt run
+
+    void addPhaseTime(RunPhase phase, std::chrono::nanoseconds elapsed) noexcept;
+    [[nodiscard]] std::chrono::nanoseconds getPhaseTime(RunPhase phase) const noexcept;
+    [[nodiscard]] std::chrono::nanoseconds getTotalTime() const noexcept;
+
+    // Reset draw counters cho categories của catalog
+    void setCategories(std::span<const domain::entities::ActivityCategory> catalogCategories);
+
+    // End-to-end throughput qua tất cả phases
+    [[nodiscard]] double studentsPerSecond() const noexcept;
+};
+
+// RAII timer cộng elapsed time vào một phase; rỗng khi stats bị tắt
+class PhaseTimer {
+public:
+    PhaseTimer(RunStatistics& statistics, RunPhase phase) noexcept
+        : statistics_(statistics)
+        , phase_(phase)
+    {
+        if constexpr (STATS_ENABLED) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~PhaseTimer() { stop(); }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    // Dừng sớm; elapsed time của phase
+    std::chrono::nanoseconds stop() noexcept
+    {
+        if constexpr (STATS_ENABLED) {
+            if (!stopped_) {
+                stopped_ = true;
+                elapsed_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_);
+                statistics_.addPhaseTime(phase_, elapsed_);
+            }
+        }
+        return elapsed_;
+    }
+
+private:
+    RunStatistics& statistics_;
+    RunPhase phase_;
+    std::chrono::steady_clock::time_point start_ {};
+    std::chrono::nanoseconds elapsed_ {};
+    bool stopped_ = false;
+};
+
+} // namespace application::services
@@ -0,0 +1,60 @@
+#include "AliasTable.h"
+#include <numeric>
+
+namespace application::strategies {
+
+AliasTable::AliasTable(std::span<const double> weights)
+    : probability_(weights.size(), 1.0)
+    , alias_(weights.size())
+{
+    const std::size_t n = weights.size();
+    if (n == 0) {
+        return;
+    }
+
+    const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    if (!(total > 0.0)) {
+        // Tất cả weights bằng 0: fallback về uniform
+        std::iota(alias_.begin(), alias_.end(), std::uint32_t { 0 });
+        return;
+    }
+
+    // Scale weights để trung bình bằng 1, chia thành small/large worklists
+    std::vector<double> scaled(n);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    small.reserve(n);
+    large.reserve(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * static_cast<double>(n) / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+
+    while (!small.empty() && !large.empty()) {
+        const auto s = small.back();
+        small.pop_back();
+        const auto l = large.back();
+
+        probability_[s] = scaled[s];
+        alias_[s] = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Phần còn lại (do sai số floating point) có probability = 1
+    for (auto i : large) {
+        probability_[i] = 1.0;
+        alias_[i] = i;
+    }
+    for (auto i : small) {
+        probability_[i] = 1.0;
+        alias_[i] = i;
+    }
+}
+
+} // namespace application::strategies
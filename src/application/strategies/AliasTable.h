@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CounterBasedRng.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace application::strategies {
+
+// Walker/Vose alias table: build O(n) một lần, sample O(1) không allocate
+class AliasTable {
+private:
+    std::vector<double> probability_;
+    std::vector<std::uint32_t> alias_;
+
+public:
+    AliasTable() = default;
+
+    // Build table từ non-negative weights (Vose's algorithm)
+    explicit AliasTable(std::span<const double> weights);
+
+    // Sample một position trong [0, size()) theo phân phối của weights
+    template <typename URBG>
+    [[nodiscard]] std::size_t sample(URBG& gen) const
+    {
+        std::uniform_int_distribution<std::size_t> column(0, probability_.size() - 1);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        const std::size_t i = column(gen);
+        return coin(gen) < probability_[i] ? i : alias_[i];
+    }
+
+    // Sample từ precomputed random bits (counter-based path, thread-safe)
+    [[nodiscard]] std::size_t sampleFromBits(DrawBits bits) const noexcept
+    {
+        const std::size_t i = boundedIndex(bits.primary, probability_.size());
+        return unitInterval(bits.secondary) < probability_[i] ? i : alias_[i];
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return probability_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return probability_.empty(); }
+};
+
+} // namespace application::strategies
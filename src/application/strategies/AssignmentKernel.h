@@ -0,0 +1,89 @@
+#pragma once
+
+#include "IRandomSelectionStrategy.h"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace application::strategies {
+
+// Strategy với non-virtual per-student Sampler (StandardRandomStrategy::Sampler, ...)
+template <typename Strategy>
+concept SamplingStrategy = requires(const Strategy& strategy,
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::size_t student) {
+    { *strategy.samplerFor(index, category, context, student) };
+    { (*strategy.samplerFor(index, category, context, student))(student) }
+        -> std::convertible_to<domain::entities::ActivityId>;
+};
+
+namespace detail {
+
+    // Row k (activityIds[k * stride, (k + 1) * stride)) là student (first + k); tất cả rows
+    // nằm trong stratum bắt đầu tại stratumStart
+    template <auto Categories, typename Strategy, std::size_t... I>
+    [[nodiscard]] bool fillStratum(std::index_sequence<I...>,
+        const Strategy& strategy,
+        const domain::entities::ActivityIndex& index,
+        const DrawContext& context,
+        std::size_t stratumStart,
+        std::size_t first,
+        std::span<domain::entities::ActivityId> activityIds)
+    {
+        constexpr std::size_t stride = sizeof...(I);
+
+        // Một sampler per category, build một lần per stratum
+        const std::tuple samplers { strategy.samplerFor(index, Categories[I], context, stratumStart)... };
+        if (!(std::get<I>(samplers).has_value() && ...)) {
+            return false;
+        }
+
+        // Categories unroll thành fold expression; sampler calls inline, không virtual dispatch
+        const std::size_t rowCount = activityIds.size() / stride;
+        for (std::size_t k = 0; k < rowCount; ++k) {
+            ((activityIds[k * stride + I] = (*std::get<I>(samplers))(first + k)), ...);
+        }
+        return true;
+    }
+
+} // namespace detail
+
+// Compile-time specialized assignment kernel cho một category set cố định (constexpr
+// std::array, vd. BUILTIN_CATEGORIES): row k của activityIds (row-major, Categories.size()
+// ids per row) nhận draws của student (context.firstStudent + k) cho mọi category.
+// Cùng (seed, student, category) cho cùng ids như virtual selectActivitiesFor()
+template <auto Categories, SamplingStrategy Strategy>
+[[nodiscard]] bool runAssignmentKernel(
+    const Strategy& strategy,
+    const domain::entities::ActivityIndex& index,
+    const DrawContext& context,
+    std::span<domain::entities::ActivityId> activityIds)
+{
+    constexpr std::size_t stride = Categories.size();
+    const std::size_t rowCount = activityIds.size() / stride;
+    if (activityIds.size() % stride != 0 || context.firstStudent + rowCount > context.rosterSize) {
+        return false;
+    }
+
+    for (std::size_t begin = 0; begin < rowCount;) {
+        const std::size_t student = context.firstStudent + begin;
+        const std::size_t stratumStart = student - student % DRAW_STRATUM_SIZE;
+        const std::size_t count = std::min(rowCount - begin, stratumStart + DRAW_STRATUM_SIZE - student);
+
+        if (!detail::fillStratum<Categories>(std::make_index_sequence<stride> {},
+                strategy, index, context, stratumStart, student,
+                activityIds.subspan(begin * stride, count * stride))) {
+            return false;
+        }
+        begin += count;
+    }
+    return true;
+}
+
+} // namespace application::strategies
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace application::strategies {
+
+// Philox4x32-10 counter-based RNG (Salmon et al., SC'11).
+// Output là pure function của (counter, key): không có mutable state nên an toàn
+// giữa các threads và mọi draw có thể recompute độc lập.
+class Philox4x32 {
+public:
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    [[nodiscard]] static constexpr Counter generate(Counter counter, Key key) noexcept
+    {
+        for (int round = 0; round < ROUNDS; ++round) {
+            const std::uint64_t product0 = std::uint64_t { MULTIPLIER_0 } * counter[0];
+            const std::uint64_t product1 = std::uint64_t { MULTIPLIER_1 } * counter[2];
+
+            counter = {
+                static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                static_cast<std::uint32_t>(product1),
+                static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                static_cast<std::uint32_t>(product0)
+            };
+
+            key[0] += WEYL_0;
+            key[1] += WEYL_1;
+        }
+        return counter;
+    }
+
+private:
+    static constexpr int ROUNDS = 10;
+    static constexpr std::uint32_t MULTIPLIER_0 = 0xD2511F53;
+    static constexpr std::uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+    static constexpr std::uint32_t WEYL_0 = 0x9E3779B9;
+    static constexpr std::uint32_t WEYL_1 = 0xBB67AE85;
+};
+
+// UniformRandomBitGenerator trên Philox: stream `stream` là dãy counters
+// {block, stream, 1}, nên các streams khác nhau (và drawBits(), dùng word cuối = 0)
+// không bao giờ overlap dưới cùng một seed
+class PhiloxEngine {
+public:
+    using result_type = std::uint32_t;
+
+    constexpr PhiloxEngine(std::uint64_t seed, std::uint32_t stream) noexcept
+        : key_ { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) }
+        , stream_(stream)
+    {
+    }
+
+    [[nodiscard]] static constexpr result_type min() noexcept { return 0; }
+    [[nodiscard]] static constexpr result_type max() noexcept { return 0xFFFFFFFFu; }
+
+    constexpr result_type operator()() noexcept
+    {
+        if (position_ == buffer_.size()) {
+            buffer_ = Philox4x32::generate(
+                { static_cast<std::uint32_t>(block_), static_cast<std::uint32_t>(block_ >> 32), stream_, 1 },
+                key_);
+            ++block_;
+            position_ = 0;
+        }
+        return buffer_[position_++];
+    }
+
+private:
+    Philox4x32::Key key_;
+    std::uint32_t stream_;
+    std::uint64_t block_ = 0;
+    Philox4x32::Counter buffer_ {};
+    std::size_t position_ = 4;
+};
+
+// 128 random bits cho draw của một student trong một stream (category)
+struct DrawBits {
+    std::uint64_t primary;
+    std::uint64_t secondary;
+};
+
+[[nodiscard]] constexpr DrawBits drawBits(
+    std::uint64_t seed, std::uint64_t studentIndex, std::uint32_t stream) noexcept
+{
+    const auto words = Philox4x32::generate(
+        { static_cast<std::uint32_t>(studentIndex),
+            static_cast<std::uint32_t>(studentIndex >> 32),
+            stream,
+            0 },
+        { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) });
+
+    return {
+        (std::uint64_t { words[0] } << 32) | words[1],
+        (std::uint64_t { words[2] } << 32) | words[3]
+    };
+}
+
+// Map 64 random bits vào [0, bound) bằng multiply-shift (high 64 bits của bits * bound)
+[[nodiscard]] constexpr std::size_t boundedIndex(std::uint64_t bits, std::uint64_t bound) noexcept
+{
+    const std::uint64_t bitsLo = bits & 0xFFFFFFFFu;
+    const std::uint64_t bitsHi = bits >> 32;
+    const std::uint64_t boundLo = bound & 0xFFFFFFFFu;
+    const std::uint64_t boundHi = bound >> 32;
+
+    const std::uint64_t lolo = bitsLo * boundLo;
+    const std::uint64_t hilo = bitsHi * boundLo;
+    const std::uint64_t lohi = bitsLo * boundHi;
+    const std::uint64_t hihi = bitsHi * boundHi;
+
+    const std::uint64_t middle = (lolo >> 32) + (hilo & 0xFFFFFFFFu) + lohi;
+    return static_cast<std::size_t>(hihi + (hilo >> 32) + (middle >> 32));
+}
+
+// Map 64 random bits vào [0, 1) với 53-bit precision
+[[nodiscard]] constexpr double unitInterval(std::uint64_t bits) noexcept
+{
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+} // namespace application::strategies
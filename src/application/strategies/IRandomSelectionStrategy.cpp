@@ -1,85 +1,392 @@
 #include "IRandomSelectionStrategy.h"
-#include <ranges>
 #include <algorithm>
+#include <utility>
 
 namespace application::strategies {
 
+namespace {
+
+// Weight based on inverse name length để favor shorter names (just for demo)
+[[nodiscard]] double nameLengthWeight(const domain::entities::Activity& activity) noexcept
+{
+    return 1.0 / std::max(1.0, static_cast<double>(activity.getName().length()));
+}
+
+// Engine của category id c dùng stream = categoryKey của c; engines được tạo khi
+// category xuất hiện lần đầu
+[[nodiscard]] PhiloxEngine& categoryEngine(
+    std::vector<PhiloxEngine>& engines, std::uint64_t seed, domain::entities::ActivityCategory category)
+{
+    const auto c = static_cast<std::size_t>(category);
+    while (engines.size() <= c) {
+        const auto id = static_cast<domain::entities::ActivityCategory>(engines.size());
+        engines.emplace_back(seed, domain::entities::Activity::categoryKey(id));
+    }
+    return engines[c];
+}
+
+} // namespace
+
+std::uint64_t generateRandomSeed()
+{
+    std::random_device rd;
+    return (std::uint64_t { rd() } << 32) | rd();
+}
+
+// Default prepare: strategies không có precomputed state
+void IRandomSelectionStrategy::prepare(const domain::entities::ActivityIndex& /*index*/) {}
+
 // StandardRandomStrategy implementation
-StandardRandomStrategy::StandardRandomStrategy() : gen_(rd_()) {}
+StandardRandomStrategy::StandardRandomStrategy() : StandardRandomStrategy(generateRandomSeed()) {}
 
-std::optional<domain::entities::Activity>
+StandardRandomStrategy::StandardRandomStrategy(std::uint64_t seed)
+    : seed_(seed) {}
+
+std::optional<domain::entities::ActivityId>
 StandardRandomStrategy::selectRandomActivity(
-    const std::vector<domain::entities::Activity>& activities,
+    const domain::entities::ActivityIndex& index,
     domain::entities::ActivityCategory category) const {
-    
-    // Sử dụng C++20 ranges để filter activities by category
-    auto categoryActivities = activities 
-        | std::views::filter([category](const auto& activity) {
-            return activity.getCategory() == category;
-        });
-    
-    // Convert view to vector for random selection
-    std::vector<domain::entities::Activity> filteredActivities(
-        categoryActivities.begin(), categoryActivities.end());
-
-    if (filteredActivities.empty()) {
+
+    // O(1): draw trực tiếp từ contiguous span của category
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
+        return std::nullopt;
+    }
+
+    std::uniform_int_distribution<size_t> dist(0, ids.size() - 1);
+    return ids[dist(categoryEngine(engines_, seed_, category))];
+}
+
+bool StandardRandomStrategy::selectRandomActivities(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    std::span<domain::entities::ActivityId> out) const {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
+        return false;
+    }
+
+    auto& engine = categoryEngine(engines_, seed_, category);
+    std::uniform_int_distribution<size_t> dist(0, ids.size() - 1);
+    for (auto& slot : out) {
+        slot = ids[dist(engine)];
+    }
+    return true;
+}
+
+std::optional<StandardRandomStrategy::Sampler> StandardRandomStrategy::samplerFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::size_t /*stratumStart*/) const noexcept {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
         return std::nullopt;
     }
+    return Sampler(context.seed, index.categoryKey(category), ids);
+}
 
-    std::uniform_int_distribution<size_t> dist(0, filteredActivities.size() - 1);
-    return filteredActivities[dist(gen_)];
+bool StandardRandomStrategy::selectActivitiesFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::span<domain::entities::ActivityId> out) const {
+
+    // Draws không phụ thuộc stratum: một sampler cho cả range
+    auto sampler = samplerFor(index, category, context, context.firstStudent);
+    if (!sampler) {
+        return false;
+    }
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        out[k] = (*sampler)(context.firstStudent + k);
+    }
+    return true;
 }
 
 std::string StandardRandomStrategy::getStrategyName() const noexcept {
     return "StandardRandomStrategy";
 }
 
+std::uint64_t StandardRandomStrategy::getSeed() const noexcept {
+    return seed_;
+}
+
 // WeightedRandomStrategy implementation
-WeightedRandomStrategy::WeightedRandomStrategy() : gen_(rd_()) {}
+WeightedRandomStrategy::WeightedRandomStrategy() : WeightedRandomStrategy(generateRandomSeed()) {}
 
-std::optional<domain::entities::Activity>
+WeightedRandomStrategy::WeightedRandomStrategy(std::uint64_t seed)
+    : seed_(seed) {}
+
+void WeightedRandomStrategy::prepare(const domain::entities::ActivityIndex& index) {
+    buildTables(index);
+}
+
+void WeightedRandomStrategy::buildTables(const domain::entities::ActivityIndex& index) const {
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto categories = index.getCategories();
+    tables_.resize(categories.size());
+
+    std::vector<double> weights;
+    for (std::size_t pool = 0; pool < categories.size(); ++pool) {
+        auto ids = index.idsFor(categories[pool]);
+
+        weights.clear();
+        weights.reserve(ids.size());
+        for (auto id : ids) {
+            weights.push_back(nameLengthWeight(index.getActivity(id)));
+        }
+        tables_[pool] = AliasTable(weights);
+    }
+
+    preparedVersion_ = index.getVersion();
+    tableBuildTime_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+std::optional<domain::entities::ActivityId>
 WeightedRandomStrategy::selectRandomActivity(
-    const std::vector<domain::entities::Activity>& activities,
+    const domain::entities::ActivityIndex& index,
     domain::entities::ActivityCategory category) const {
-    
-    // Sử dụng C++20 ranges để filter activities by category
-    auto categoryActivities = activities 
-        | std::views::filter([category](const auto& activity) {
-            return activity.getCategory() == category;
-        });
-    
-    // Convert view to vector for weighted selection
-    std::vector<domain::entities::Activity> filteredActivities(
-        categoryActivities.begin(), categoryActivities.end());
-
-    if (filteredActivities.empty()) {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
         return std::nullopt;
     }
 
-    // Weighted selection based on name length (just for demo)
-    std::vector<double> weights;
-    weights.reserve(filteredActivities.size());
+    // Lazy build nếu caller chưa gọi prepare() cho index này
+    if (preparedVersion_ != index.getVersion()) {
+        buildTables(index);
+    }
 
-    for (const auto& activity : filteredActivities) {
-        // Weight based on inverse name length để favor shorter names
-        weights.push_back(1.0 / std::max(1.0, static_cast<double>(activity.getName().length())));
+    // O(1) alias-method sampling
+    return ids[tables_[index.poolOf(category)].sample(categoryEngine(engines_, seed_, category))];
+}
+
+bool WeightedRandomStrategy::selectRandomActivities(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    std::span<domain::entities::ActivityId> out) const {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
+        return false;
+    }
+
+    if (preparedVersion_ != index.getVersion()) {
+        buildTables(index);
+    }
+
+    const auto& table = tables_[index.poolOf(category)];
+    auto& engine = categoryEngine(engines_, seed_, category);
+    for (auto& slot : out) {
+        slot = ids[table.sample(engine)];
+    }
+    return true;
+}
+
+std::optional<WeightedRandomStrategy::Sampler> WeightedRandomStrategy::samplerFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::size_t /*stratumStart*/) const noexcept {
+
+    auto ids = index.idsFor(category);
+
+    // Không lazy build ở đây: path này có thể chạy song song, nên cần prepare() trước
+    if (ids.empty() || preparedVersion_ != index.getVersion()) {
+        return std::nullopt;
     }
+    return Sampler(context.seed, index.categoryKey(category), ids, tables_[index.poolOf(category)]);
+}
+
+bool WeightedRandomStrategy::selectActivitiesFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::span<domain::entities::ActivityId> out) const {
 
-    std::discrete_distribution<size_t> dist(weights.begin(), weights.end());
-    return filteredActivities[dist(gen_)];
+    auto sampler = samplerFor(index, category, context, context.firstStudent);
+    if (!sampler) {
+        return false;
+    }
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        out[k] = (*sampler)(context.firstStudent + k);
+    }
+    return true;
 }
 
 std::string WeightedRandomStrategy::getStrategyName() const noexcept {
     return "WeightedRandomStrategy";
 }
 
+std::uint64_t WeightedRandomStrategy::getSeed() const noexcept {
+    return seed_;
+}
+
+std::chrono::nanoseconds WeightedRandomStrategy::getTableBuildTime() const noexcept {
+    return tableBuildTime_;
+}
+
+std::chrono::nanoseconds WeightedRandomStrategy::measureSampleTime(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    std::size_t draws) const {
+
+    const auto start = std::chrono::steady_clock::now();
+    domain::entities::ActivityId checksum = 0;
+    for (std::size_t i = 0; i < draws; ++i) {
+        checksum ^= selectRandomActivity(index, category).value_or(0);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // Giữ checksum để compiler không loại bỏ vòng lặp
+    volatile auto sink = checksum;
+    (void)sink;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+}
+
+// BalancedRandomStrategy implementation
+BalancedRandomStrategy::BalancedRandomStrategy() : BalancedRandomStrategy(generateRandomSeed()) {}
+
+BalancedRandomStrategy::BalancedRandomStrategy(std::uint64_t seed) : seed_(seed) {}
+
+void BalancedRandomStrategy::shuffleStratum(
+    std::uint64_t seed,
+    std::size_t stratumStart,
+    std::size_t stratumSize,
+    std::uint32_t stream,
+    Permutation& permutation) noexcept {
+
+    for (std::size_t i = 0; i < stratumSize; ++i) {
+        permutation[i] = static_cast<std::uint16_t>(i);
+    }
+
+    // Swap step i dùng counter của position (stratumStart + i): pure function của seed
+    for (std::size_t i = stratumSize; i > 1; --i) {
+        const auto bits = drawBits(seed, stratumStart + i - 1, stream);
+        std::swap(permutation[i - 1], permutation[boundedIndex(bits.primary, i)]);
+    }
+}
+
+std::optional<domain::entities::ActivityId>
+BalancedRandomStrategy::selectRandomActivity(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category) const {
+
+    domain::entities::ActivityId id {};
+    if (!selectRandomActivities(index, category, std::span(&id, 1))) {
+        return std::nullopt;
+    }
+    return id;
+}
+
+bool BalancedRandomStrategy::selectRandomActivities(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    std::span<domain::entities::ActivityId> out) const {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty()) {
+        return false;
+    }
+
+    const auto c = static_cast<std::size_t>(category);
+    if (cursors_.size() <= c) {
+        cursors_.resize(c + 1);
+    }
+
+    // Reuse permutation của stratum hiện tại giữa các calls
+    auto& cursor = cursors_[c];
+    for (auto& slot : out) {
+        const std::size_t stratumStart = cursor.position - cursor.position % DRAW_STRATUM_SIZE;
+        if (!cursor.permuted || cursor.permutedStratum != stratumStart) {
+            shuffleStratum(seed_, stratumStart, DRAW_STRATUM_SIZE, index.categoryKey(category), cursor.permutation);
+            cursor.permutedStratum = stratumStart;
+            cursor.permuted = true;
+        }
+        slot = ids[(stratumStart + cursor.permutation[cursor.position - stratumStart]) % ids.size()];
+        ++cursor.position;
+    }
+    return true;
+}
+
+bool BalancedRandomStrategy::selectActivitiesFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::span<domain::entities::ActivityId> out) const {
+
+    if (context.firstStudent + out.size() > context.rosterSize) {
+        return false;
+    }
+
+    // Sampler nằm trên stack: không allocate per call; mỗi stratum chạm tới được shuffle một lần
+    const std::size_t end = context.firstStudent + out.size();
+    for (std::size_t student = context.firstStudent; student < end;) {
+        const std::size_t stratumStart = student - student % DRAW_STRATUM_SIZE;
+        const auto sampler = samplerFor(index, category, context, stratumStart);
+        if (!sampler) {
+            return false;
+        }
+
+        const std::size_t stratumEnd = std::min(stratumStart + DRAW_STRATUM_SIZE, end);
+        for (; student < stratumEnd; ++student) {
+            out[student - context.firstStudent] = (*sampler)(student);
+        }
+    }
+    return true;
+}
+
+std::optional<BalancedRandomStrategy::Sampler> BalancedRandomStrategy::samplerFor(
+    const domain::entities::ActivityIndex& index,
+    domain::entities::ActivityCategory category,
+    const DrawContext& context,
+    std::size_t stratumStart) const noexcept {
+
+    auto ids = index.idsFor(category);
+    if (ids.empty() || stratumStart >= context.rosterSize) {
+        return std::nullopt;
+    }
+
+    const std::size_t stratumSize = std::min(DRAW_STRATUM_SIZE, context.rosterSize - stratumStart);
+    return std::optional<Sampler>(std::in_place, context.seed, index.categoryKey(category), ids, stratumStart, stratumSize);
+}
+
+std::string BalancedRandomStrategy::getStrategyName() const noexcept {
+    return "BalancedRandomStrategy";
+}
+
+std::uint64_t BalancedRandomStrategy::getSeed() const noexcept {
+    return seed_;
+}
+
 // Factory functions implementation
 std::unique_ptr<IRandomSelectionStrategy> createStandardRandomStrategy() {
     return std::make_unique<StandardRandomStrategy>();
 }
 
+std::unique_ptr<IRandomSelectionStrategy> createStandardRandomStrategy(std::uint64_t seed) {
+    return std::make_unique<StandardRandomStrategy>(seed);
+}
+
 std::unique_ptr<IRandomSelectionStrategy> createWeightedRandomStrategy() {
     return std::make_unique<WeightedRandomStrategy>();
 }
 
+std::unique_ptr<IRandomSelectionStrategy> createWeightedRandomStrategy(std::uint64_t seed) {
+    return std::make_unique<WeightedRandomStrategy>(seed);
+}
+
+std::unique_ptr<IRandomSelectionStrategy> createBalancedRandomStrategy() {
+    return std::make_unique<BalancedRandomStrategy>();
+}
+
+std::unique_ptr<IRandomSelectionStrategy> createBalancedRandomStrategy(std::uint64_t seed) {
+    return std::make_unique<BalancedRandomStrategy>(seed);
+}
+
 } // namespace application::strategies
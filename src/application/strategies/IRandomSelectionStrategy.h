@@ -1,65 +1,320 @@
 #pragma once
 
 #include "../../domain/entities/Activity.h"
+#include "../../domain/entities/ActivityIndex.h"
+#include "AliasTable.h"
+#include "CounterBasedRng.h"
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <random>
+#include <span>
 #include <vector>
 
 namespace application::strategies {
 
+// Counter-based draw context: draws của student i là pure function của (seed, i, category)
+// (và rosterSize với strategies group students thành strata)
+struct DrawContext {
+    std::uint64_t seed;
+    std::size_t firstStudent; // Global roster index của out[0]
+    std::size_t rosterSize;   // Số students của run, hoặc đã đọc tới cuối chunk hiện tại
+};
+
+// Strata [i * DRAW_STRATUM_SIZE, (i + 1) * DRAW_STRATUM_SIZE) của roster; streaming chunks
+// được align theo size này để chỉ stratum cuối của roster có thể thiếu
+inline constexpr std::size_t DRAW_STRATUM_SIZE = 4096;
+
 // Strategy Pattern - Abstract strategy interface
 class IRandomSelectionStrategy {
 public:
     virtual ~IRandomSelectionStrategy() = default;
 
-    // Strategy method để select random activity
-    [[nodiscard]] virtual std::optional<domain::entities::Activity>
+    // Hook được gọi một lần sau mỗi lần build index, để precompute per-catalog tables
+    virtual void prepare(const domain::entities::ActivityIndex& index);
+
+    // Strategy method để select random activity id từ prebuilt index
+    [[nodiscard]] virtual std::optional<domain::entities::ActivityId>
     selectRandomActivity(
-        const std::vector<domain::entities::Activity>& activities,
+        const domain::entities::ActivityIndex& index,
         domain::entities::ActivityCategory category) const = 0;
 
+    // Batch method: fill `out` với out.size() random activity ids của category trong một call.
+    // Returns false nếu category không có activity nào
+    [[nodiscard]] virtual bool
+    selectRandomActivities(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        std::span<domain::entities::ActivityId> out) const = 0;
+
+    // Counter-based batch method: out[k] là draw của student (context.firstStudent + k).
+    // Không touch mutable state nên có thể gọi song song từ nhiều threads sau prepare();
+    // kết quả không phụ thuộc vào cách chia roster
+    [[nodiscard]] virtual bool
+    selectActivitiesFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::span<domain::entities::ActivityId> out) const = 0;
+
     // Get strategy name
     [[nodiscard]] virtual std::string getStrategyName() const noexcept = 0;
+
+    // Seed của strategy; cùng seed thì cùng draws
+    [[nodiscard]] virtual std::uint64_t getSeed() const noexcept = 0;
 };
 
 // Concrete Strategy 1: Standard Random Selection
 class StandardRandomStrategy : public IRandomSelectionStrategy {
 private:
-    mutable std::random_device rd_;
-    mutable std::mt19937 gen_;
+    std::uint64_t seed_;
+
+    // Một independent Philox stream per category id cho stateful draws, tạo lazily
+    mutable std::vector<PhiloxEngine> engines_;
 
 public:
-    StandardRandomStrategy();
+    // Non-virtual per-student draw cho compile-time kernel (AssignmentKernel.h):
+    // sampler(student) == selectActivitiesFor() của cùng student.
+    // stream = categoryKey của category, nên draws không phụ thuộc category ids
+    class Sampler {
+    public:
+        Sampler(std::uint64_t seed, std::uint32_t stream,
+            std::span<const domain::entities::ActivityId> ids) noexcept
+            : seed_(seed)
+            , stream_(stream)
+            , ids_(ids)
+        {
+        }
+
+        [[nodiscard]] domain::entities::ActivityId operator()(std::size_t student) const noexcept
+        {
+            return ids_[boundedIndex(drawBits(seed_, student, stream_).primary, ids_.size())];
+        }
+
+    private:
+        std::uint64_t seed_;
+        std::uint32_t stream_;
+        std::span<const domain::entities::ActivityId> ids_;
+    };
 
-    [[nodiscard]] std::optional<domain::entities::Activity>
+    StandardRandomStrategy(); // Seed từ std::random_device
+    explicit StandardRandomStrategy(std::uint64_t seed);
+
+    // Sampler cho students của stratum bắt đầu tại stratumStart; nullopt nếu category rỗng
+    [[nodiscard]] std::optional<Sampler> samplerFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::size_t stratumStart) const noexcept;
+
+    [[nodiscard]] std::optional<domain::entities::ActivityId>
     selectRandomActivity(
-        const std::vector<domain::entities::Activity>& activities,
+        const domain::entities::ActivityIndex& index,
         domain::entities::ActivityCategory category) const override;
 
+    [[nodiscard]] bool
+    selectRandomActivities(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        std::span<domain::entities::ActivityId> out) const override;
+
+    [[nodiscard]] bool
+    selectActivitiesFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::span<domain::entities::ActivityId> out) const override;
+
     [[nodiscard]] std::string getStrategyName() const noexcept override;
+
+    [[nodiscard]] std::uint64_t getSeed() const noexcept override;
 };
 
-// Concrete Strategy 2: Weighted Random Selection
+// Concrete Strategy 2: Weighted Random Selection với per-category alias tables
 class WeightedRandomStrategy : public IRandomSelectionStrategy {
 private:
-    mutable std::random_device rd_;
-    mutable std::mt19937 gen_;
+    std::uint64_t seed_;
+
+    // Một independent Philox stream per category id cho stateful draws, tạo lazily
+    mutable std::vector<PhiloxEngine> engines_;
+
+    // Một alias table per pool của index, build lại khi index version thay đổi
+    mutable std::vector<AliasTable> tables_;
+    mutable std::uint64_t preparedVersion_ = 0;
+    mutable std::chrono::nanoseconds tableBuildTime_ {};
+
+    void buildTables(const domain::entities::ActivityIndex& index) const;
+
+public:
+    // Non-virtual per-student draw cho compile-time kernel; table phải sống lâu hơn sampler
+    class Sampler {
+    public:
+        Sampler(std::uint64_t seed, std::uint32_t stream,
+            std::span<const domain::entities::ActivityId> ids, const AliasTable& table) noexcept
+            : seed_(seed)
+            , stream_(stream)
+            , ids_(ids)
+            , table_(&table)
+        {
+        }
+
+        [[nodiscard]] domain::entities::ActivityId operator()(std::size_t student) const noexcept
+        {
+            return ids_[table_->sampleFromBits(drawBits(seed_, student, stream_))];
+        }
+
+    private:
+        std::uint64_t seed_;
+        std::uint32_t stream_;
+        std::span<const domain::entities::ActivityId> ids_;
+        const AliasTable* table_;
+    };
+
+    WeightedRandomStrategy(); // Seed từ std::random_device
+    explicit WeightedRandomStrategy(std::uint64_t seed);
+
+    // nullopt nếu category rỗng hoặc chưa prepare() với index
+    [[nodiscard]] std::optional<Sampler> samplerFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::size_t stratumStart) const noexcept;
+
+    void prepare(const domain::entities::ActivityIndex& index) override;
+
+    [[nodiscard]] std::optional<domain::entities::ActivityId>
+    selectRandomActivity(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category) const override;
+
+    [[nodiscard]] bool
+    selectRandomActivities(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        std::span<domain::entities::ActivityId> out) const override;
+
+    [[nodiscard]] bool
+    selectActivitiesFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::span<domain::entities::ActivityId> out) const override;
+
+    [[nodiscard]] std::string getStrategyName() const noexcept override;
+
+    [[nodiscard]] std::uint64_t getSeed() const noexcept override;
+
+    // Thời gian build alias tables của lần prepare gần nhất
+    [[nodiscard]] std::chrono::nanoseconds getTableBuildTime() const noexcept;
+
+    // Đo tổng thời gian của `draws` lần sample trong category
+    [[nodiscard]] std::chrono::nanoseconds measureSampleTime(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        std::size_t draws) const;
+};
+
+// Concrete Strategy 3: Balanced stratified selection.
+// Position p của roster nhận activity ids[p % k]; sequence lặp này được shuffle trong
+// từng stratum bằng Fisher-Yates keyed theo (seed, stratum, category key), nên mỗi activity
+// nhận đúng floor/ceil(N/k) students và mỗi stratum cũng balanced
+class BalancedRandomStrategy : public IRandomSelectionStrategy {
+private:
+    using Permutation = std::array<std::uint16_t, DRAW_STRATUM_SIZE>;
+
+    std::uint64_t seed_;
+
+    // Stateful draws đi qua một roster không giới hạn, bắt đầu từ position 0;
+    // permutation của stratum hiện tại được giữ giữa các calls
+    struct StatefulCursor {
+        std::size_t position = 0;
+        std::size_t permutedStratum = 0;
+        bool permuted = false;
+        Permutation permutation {};
+    };
+
+    // Một cursor per category id, tạo lazily
+    mutable std::vector<StatefulCursor> cursors_;
+
+    // permutation[0, stratumSize) = Fisher-Yates shuffle của 0..stratumSize-1
+    static void shuffleStratum(
+        std::uint64_t seed,
+        std::size_t stratumStart,
+        std::size_t stratumSize,
+        std::uint32_t stream,
+        Permutation& permutation) noexcept;
 
 public:
-    WeightedRandomStrategy();
+    // Non-virtual per-student draw cho compile-time kernel: permutation của một stratum
+    // được build trong constructor, mỗi draw chỉ là một lookup
+    class Sampler {
+    public:
+        Sampler(std::uint64_t seed, std::uint32_t stream,
+            std::span<const domain::entities::ActivityId> ids,
+            std::size_t stratumStart, std::size_t stratumSize) noexcept
+            : ids_(ids)
+            , stratumStart_(stratumStart)
+        {
+            shuffleStratum(seed, stratumStart, stratumSize, stream, permutation_);
+        }
+
+        // student phải nằm trong stratum của sampler
+        [[nodiscard]] domain::entities::ActivityId operator()(std::size_t student) const noexcept
+        {
+            return ids_[(stratumStart_ + permutation_[student - stratumStart_]) % ids_.size()];
+        }
+
+    private:
+        std::span<const domain::entities::ActivityId> ids_;
+        std::size_t stratumStart_;
+        Permutation permutation_;
+    };
 
-    [[nodiscard]] std::optional<domain::entities::Activity>
+    BalancedRandomStrategy(); // Seed từ std::random_device
+    explicit BalancedRandomStrategy(std::uint64_t seed);
+
+    // nullopt nếu category rỗng hoặc stratum nằm ngoài context.rosterSize
+    [[nodiscard]] std::optional<Sampler> samplerFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::size_t stratumStart) const noexcept;
+
+    [[nodiscard]] std::optional<domain::entities::ActivityId>
     selectRandomActivity(
-        const std::vector<domain::entities::Activity>& activities,
+        const domain::entities::ActivityIndex& index,
         domain::entities::ActivityCategory category) const override;
 
+    [[nodiscard]] bool
+    selectRandomActivities(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        std::span<domain::entities::ActivityId> out) const override;
+
+    [[nodiscard]] bool
+    selectActivitiesFor(
+        const domain::entities::ActivityIndex& index,
+        domain::entities::ActivityCategory category,
+        const DrawContext& context,
+        std::span<domain::entities::ActivityId> out) const override;
+
     [[nodiscard]] std::string getStrategyName() const noexcept override;
+
+    [[nodiscard]] std::uint64_t getSeed() const noexcept override;
 };
 
+// Non-deterministic 64-bit seed từ std::random_device
+[[nodiscard]] std::uint64_t generateRandomSeed();
+
 // Factory functions để create strategies
 [[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createStandardRandomStrategy();
+[[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createStandardRandomStrategy(std::uint64_t seed);
 [[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createWeightedRandomStrategy();
+[[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createWeightedRandomStrategy(std::uint64_t seed);
+[[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createBalancedRandomStrategy();
+[[nodiscard]] std::unique_ptr<IRandomSelectionStrategy> createBalancedRandomStrategy(std::uint64_t seed);
 
 } // namespace application::strategies
@@ -1,42 +1,230 @@
 #include "Activity.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace domain::entities {
 
+namespace {
+
+// Transparent hash để lookup bằng string_view không cần tạo std::string
+struct NameHash {
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(std::string_view name) const noexcept
+    {
+        return std::hash<std::string_view> {}(name);
+    }
+};
+
+// FNV-1a 32-bit: key phải giống nhau giữa các processes và builds, nên không dùng std::hash
+[[nodiscard]] std::uint32_t stableHash(std::string_view name) noexcept
+{
+    std::uint32_t hash = 2166136261u;
+    for (unsigned char c : name) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+// Built-in categories giữ key = id; key của categories khác có high bit set nên không
+// trùng built-ins
+constexpr std::uint32_t DATA_CATEGORY_KEY_BIT = 0x8000'0000u;
+
+// Process-wide append-only interner: id = vị trí của name trong names.
+// Ids không bao giờ bị reuse nên ActivityCategory values vẫn valid giữa các catalogs
+class CategoryRegistry {
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;
+    std::deque<std::uint32_t> keys_;
+    std::unordered_map<std::string, ActivityCategory, NameHash, std::equal_to<>> ids_;
+    bool restricted_ = false; // true: chỉ names đã register được chấp nhận
+    // Categories mà mọi catalog phải có activities: built-ins, hoặc list của restrict()
+    std::vector<ActivityCategory> required_ { BUILTIN_CATEGORIES.begin(), BUILTIN_CATEGORIES.end() };
+
+    void add(std::string_view name, std::uint32_t key)
+    {
+        const auto id = static_cast<ActivityCategory>(names_.size());
+        names_.emplace_back(name);
+        keys_.push_back(key);
+        ids_.emplace(names_.back(), id);
+    }
+
+public:
+    CategoryRegistry()
+    {
+        for (std::string_view name : { "Class", "Union", "School" }) {
+            add(name, static_cast<std::uint32_t>(names_.size()));
+        }
+    }
+
+    [[nodiscard]] std::uint32_t keyOf(ActivityCategory category) const
+    {
+        std::shared_lock lock(mutex_);
+        const auto id = static_cast<std::size_t>(category);
+        return id < keys_.size() ? keys_[id] : static_cast<std::uint32_t>(id);
+    }
+
+    [[nodiscard]] bool isRestricted() const
+    {
+        std::shared_lock lock(mutex_);
+        return restricted_;
+    }
+
+    void restrict(std::vector<ActivityCategory> required)
+    {
+        std::unique_lock lock(mutex_);
+        restricted_ = true;
+        required_ = std::move(required);
+    }
+
+    [[nodiscard]] std::vector<ActivityCategory> required() const
+    {
+        std::shared_lock lock(mutex_);
+        return required_;
+    }
+
+    [[nodiscard]] std::optional<std::string> nameOf(ActivityCategory category) const
+    {
+        std::shared_lock lock(mutex_);
+        const auto id = static_cast<std::size_t>(category);
+        if (id >= names_.size()) {
+            return std::nullopt;
+        }
+        return names_[id];
+    }
+
+    [[nodiscard]] std::optional<ActivityCategory> find(std::string_view name) const
+    {
+        std::shared_lock lock(mutex_);
+        auto it = ids_.find(name);
+        if (it == ids_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    [[nodiscard]] std::optional<ActivityCategory> intern(std::string_view name)
+    {
+        if (auto existing = find(name)) {
+            return existing;
+        }
+
+        std::unique_lock lock(mutex_);
+        // Thread khác có thể đã register name giữa hai locks
+        if (auto it = ids_.find(name); it != ids_.end()) {
+            return it->second;
+        }
+        if (restricted_ || names_.size() >= MAX_CATEGORY_COUNT) {
+            return std::nullopt;
+        }
+        const auto id = static_cast<ActivityCategory>(names_.size());
+        add(name, stableHash(name) | DATA_CATEGORY_KEY_BIT);
+        return id;
+    }
+};
+
+[[nodiscard]] CategoryRegistry& registry()
+{
+    static CategoryRegistry instance;
+    return instance;
+}
+
+} // namespace
+
 // Constructor implementations
-Activity::Activity() : name_(""), category_(ActivityCategory::Class) {}
+Activity::Activity() : category_(ActivityCategory::Class), capacity_(UNLIMITED_CAPACITY) {}
 
-Activity::Activity(std::string name, ActivityCategory category) 
-    : name_(std::move(name)), category_(category) {}
+Activity::Activity(std::string_view name, ActivityCategory category, std::uint32_t capacity)
+    : Activity(std::make_shared<ActivityNameArena>(), name, category, capacity) {}
 
-// Getter implementations  
-const std::string& Activity::getName() const noexcept { 
-    return name_; 
+Activity::Activity(const std::shared_ptr<ActivityNameArena>& arena, std::string_view name,
+    ActivityCategory category, std::uint32_t capacity)
+    : arena_(arena), category_(category), capacity_(capacity) {
+    const auto categoryName = categoryToString(category);
+    labelOffset_ = arena->appendLabel(name, categoryName);
+    nameLength_ = static_cast<std::uint32_t>(name.size());
+    labelLength_ = static_cast<std::uint32_t>(arena->size() - labelOffset_);
 }
 
-ActivityCategory Activity::getCategory() const noexcept { 
-    return category_; 
+Activity::Activity(std::shared_ptr<const ActivityNameArena> arena, std::uint32_t labelOffset,
+    std::uint32_t nameLength, std::uint32_t labelLength, ActivityCategory category, std::uint32_t capacity)
+    : arena_(std::move(arena)), labelOffset_(labelOffset), nameLength_(nameLength), labelLength_(labelLength)
+    , category_(category), capacity_(capacity) {}
+
+// Getter implementations
+std::string_view Activity::getName() const noexcept {
+    return arena_ ? arena_->view(labelOffset_, nameLength_) : std::string_view {};
+}
+
+ActivityCategory Activity::getCategory() const noexcept {
+    return category_;
+}
+
+std::uint32_t Activity::getCapacity() const noexcept {
+    return capacity_;
+}
+
+bool Activity::hasCapacityLimit() const noexcept {
+    return capacity_ != UNLIMITED_CAPACITY;
 }
 
 // Utility function implementations
-std::string Activity::getFormattedActivity() const {
-    return name_ + " (" + categoryToString(category_) + ")";
+std::string_view Activity::getFormattedActivity() const noexcept {
+    return arena_ ? arena_->view(labelOffset_, labelLength_) : std::string_view {};
 }
 
-// Static utility functions
+bool Activity::operator==(const Activity& other) const noexcept {
+    return category_ == other.category_ && capacity_ == other.capacity_ && getName() == other.getName();
+}
+
+// Static utility functions: O(1) hash lookup thay vì so sánh lần lượt từng name
 std::string Activity::categoryToString(ActivityCategory category) {
-    switch (category) {
-        case ActivityCategory::Class: return "Class";
-        case ActivityCategory::Union: return "Union";  
-        case ActivityCategory::School: return "School";
-        default: return "Unknown";
+    return registry().nameOf(category).value_or("Unknown");
+}
+
+std::optional<ActivityCategory> Activity::stringToCategory(std::string_view name) {
+    return registry().find(name);
+}
+
+std::optional<ActivityCategory> Activity::internCategory(std::string_view name) {
+    if (name.empty() || name.find_first_of(",\r\n") != std::string_view::npos) {
+        return std::nullopt;
+    }
+    return registry().intern(name);
+}
+
+bool Activity::restrictCategories(std::span<const std::string> names) {
+    std::vector<ActivityCategory> required;
+    for (const auto& name : names) {
+        const auto category = internCategory(name);
+        if (!category) {
+            return false;
+        }
+        if (std::ranges::find(required, *category) == required.end()) {
+            required.push_back(*category);
+        }
     }
+    registry().restrict(std::move(required));
+    return true;
+}
+
+bool Activity::categoriesRestricted() {
+    return registry().isRestricted();
+}
+
+std::vector<ActivityCategory> Activity::requiredCategories() {
+    return registry().required();
 }
 
-std::optional<ActivityCategory> Activity::stringToCategory(const std::string& str) {
-    if (str == "Class") return ActivityCategory::Class;
-    if (str == "Union") return ActivityCategory::Union;
-    if (str == "School") return ActivityCategory::School;
-    return std::nullopt;
+std::uint32_t Activity::categoryKey(ActivityCategory category) {
+    return registry().keyOf(category);
 }
 
 } // namespace domain::entities
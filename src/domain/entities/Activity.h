@@ -1,44 +1,105 @@
 #pragma once
 
+#include "ActivityNameArena.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace domain::entities {
 
-// Enum class cho category với C++11 scoped enums
-enum class ActivityCategory {
+// Dense category id. Categories được intern từ names trong catalog (data-driven);
+// Class/Union/School là built-in categories với ids cố định 0..2
+enum class ActivityCategory : std::uint16_t {
     Class,
     Union,
     School
 };
 
-// Activity entity với các tính năng C++ hiện đại
+// Categories được pre-intern theo thứ tự id
+inline constexpr std::array BUILTIN_CATEGORIES = {
+    ActivityCategory::Class,
+    ActivityCategory::Union,
+    ActivityCategory::School
+};
+
+// Số category ids tối đa trong một process
+inline constexpr std::size_t MAX_CATEGORY_COUNT = std::numeric_limits<std::uint16_t>::max();
+
+// Activity entity với các tính năng C++ hiện đại.
+// Name và label nằm trong ActivityNameArena được share bởi cả catalog; activity chỉ
+// giữ offsets, nên copy / return một activity không allocate
 class Activity {
+public:
+    // Capacity mặc định khi activities.txt không có seat limit
+    static constexpr std::uint32_t UNLIMITED_CAPACITY = std::numeric_limits<std::uint32_t>::max();
+
 private:
-    std::string name_;
+    std::shared_ptr<const ActivityNameArena> arena_; // nullptr: name rỗng
+    std::uint32_t labelOffset_ = 0;
+    std::uint32_t nameLength_ = 0;                   // Name là prefix của label
+    std::uint32_t labelLength_ = 0;
     ActivityCategory category_;
+    std::uint32_t capacity_;
 
 public:
     // Constructors
     Activity();
-    Activity(std::string name, ActivityCategory category);
 
-    // Getters với const correctness
-    [[nodiscard]] const std::string& getName() const noexcept;
+    // Activity với arena riêng: một arena allocation cho mỗi activity, chỉ dùng cho
+    // tests và tools; loaders build catalog bằng constructor share arena bên dưới
+    Activity(std::string_view name, ActivityCategory category, std::uint32_t capacity = UNLIMITED_CAPACITY);
+
+    // Append name và label vào arena của catalog đang được build
+    Activity(const std::shared_ptr<ActivityNameArena>& arena, std::string_view name,
+        ActivityCategory category, std::uint32_t capacity = UNLIMITED_CAPACITY);
+
+    // Activity cho label đã có trong arena tại labelOffset (name là prefix nameLength bytes),
+    // để loaders build labels song song rồi merge arenas
+    Activity(std::shared_ptr<const ActivityNameArena> arena, std::uint32_t labelOffset,
+        std::uint32_t nameLength, std::uint32_t labelLength, ActivityCategory category, std::uint32_t capacity);
+
+    // Getters với const correctness; views valid trong lifetime của activity (hoặc copies)
+    [[nodiscard]] std::string_view getName() const noexcept;
     [[nodiscard]] ActivityCategory getCategory() const noexcept;
+    [[nodiscard]] std::uint32_t getCapacity() const noexcept;
+    [[nodiscard]] bool hasCapacityLimit() const noexcept;
 
-    // Utility function để format activity
-    [[nodiscard]] std::string getFormattedActivity() const;
+    // Label "Name (Category)", render một lần khi activity được tạo
+    [[nodiscard]] std::string_view getFormattedActivity() const noexcept;
 
-    // Static utility function để convert enum sang string
+    // Name của category id đã intern ("Unknown" nếu chưa)
     [[nodiscard]] static std::string categoryToString(ActivityCategory category);
 
-    // Static function để parse string thành ActivityCategory với std::optional
-    [[nodiscard]] static std::optional<ActivityCategory> stringToCategory(const std::string& str);
+    // Lookup category đã intern, không register name mới
+    [[nodiscard]] static std::optional<ActivityCategory> stringToCategory(std::string_view name);
+
+    // Id của category name, register id mới (dense, tăng dần) nếu name chưa có.
+    // nullopt nếu name rỗng, chứa ',' / newline, đã hết ids, hoặc name chưa có khi
+    // categories đã bị restrict. Thread-safe
+    [[nodiscard]] static std::optional<ActivityCategory> internCategory(std::string_view name);
+
+    // Intern names rồi chỉ chấp nhận các categories đã có (built-ins và names), để typo
+    // trong catalog là lỗi thay vì category mới; names trở thành required categories.
+    // false nếu có name không hợp lệ
+    [[nodiscard]] static bool restrictCategories(std::span<const std::string> names);
+    [[nodiscard]] static bool categoriesRestricted();
+
+    // Categories mà catalog phải có ít nhất một activity: built-ins, hoặc names của
+    // restrictCategories()
+    [[nodiscard]] static std::vector<ActivityCategory> requiredCategories();
+
+    // Key ổn định của category, chỉ phụ thuộc name (không phụ thuộc thứ tự intern trong
+    // process): built-ins giữ id của chúng, categories khác là hash của name
+    [[nodiscard]] static std::uint32_t categoryKey(ActivityCategory category);
 
-    // Equality operators
-    bool operator==(const Activity& other) const = default;
-    bool operator!=(const Activity& other) const = default;
+    // Equality theo nội dung (name, category, capacity), không theo arena
+    bool operator==(const Activity& other) const noexcept;
 };
 
 } // namespace domain::entities
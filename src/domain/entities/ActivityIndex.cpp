@@ -0,0 +1,115 @@
+#include "ActivityIndex.h"
+#include <atomic>
+
+namespace domain::entities {
+
+namespace {
+
+std::atomic<std::uint64_t> nextIndexVersion { 1 };
+
+} // namespace
+
+// Build index bằng counting sort (stable) theo category: O(activities + max category id)
+ActivityIndex::ActivityIndex(std::vector<Activity> activities)
+    : activities_(std::move(activities))
+    , version_(nextIndexVersion.fetch_add(1, std::memory_order_relaxed))
+{
+    // Ids của categories không built-in phụ thuộc thứ tự intern trong process (daemon
+    // reloads), nên pools của chúng theo thứ tự xuất hiện trong catalog thay vì theo id
+    std::vector<std::size_t> counts;
+    std::vector<ActivityCategory> dataCategories;
+    for (const auto& activity : activities_) {
+        const auto c = static_cast<std::size_t>(activity.getCategory());
+        if (c >= counts.size()) {
+            counts.resize(c + 1);
+        }
+        if (counts[c]++ == 0 && c >= BUILTIN_CATEGORIES.size()) {
+            dataCategories.push_back(activity.getCategory());
+        }
+    }
+
+    // Chỉ categories có activities mới có pool
+    poolOfCategory_.assign(counts.size(), NO_POOL);
+    poolOffsets_.push_back(0);
+    auto addPool = [&](ActivityCategory category) {
+        const auto c = static_cast<std::size_t>(category);
+        poolOfCategory_[c] = static_cast<std::uint32_t>(categories_.size());
+        categories_.push_back(category);
+        categoryKeys_.push_back(Activity::categoryKey(category));
+        poolOffsets_.push_back(poolOffsets_.back() + counts[c]);
+    };
+    for (const auto category : BUILTIN_CATEGORIES) {
+        const auto c = static_cast<std::size_t>(category);
+        if (c < counts.size() && counts[c] > 0) {
+            addPool(category);
+        }
+    }
+    for (const auto category : dataCategories) {
+        addPool(category);
+    }
+
+    idsByCategory_.resize(activities_.size());
+    auto cursor = poolOffsets_;
+    for (std::size_t id = 0; id < activities_.size(); ++id) {
+        const auto pool = poolOfCategory_[static_cast<std::size_t>(activities_[id].getCategory())];
+        idsByCategory_[cursor[pool]++] = static_cast<ActivityId>(id);
+    }
+}
+
+std::span<const ActivityId> ActivityIndex::idsFor(ActivityCategory category) const noexcept
+{
+    if (!hasCategory(category)) {
+        return {};
+    }
+    const auto pool = poolOf(category);
+    return std::span<const ActivityId>(idsByCategory_).subspan(
+        poolOffsets_[pool], poolOffsets_[pool + 1] - poolOffsets_[pool]);
+}
+
+std::span<const ActivityCategory> ActivityIndex::getCategories() const noexcept
+{
+    return categories_;
+}
+
+std::size_t ActivityIndex::categoryCount() const noexcept
+{
+    return categories_.size();
+}
+
+std::size_t ActivityIndex::poolOf(ActivityCategory category) const noexcept
+{
+    return poolOfCategory_[static_cast<std::size_t>(category)];
+}
+
+std::uint32_t ActivityIndex::categoryKey(ActivityCategory category) const noexcept
+{
+    return categoryKeys_[poolOf(category)];
+}
+
+const Activity& ActivityIndex::getActivity(ActivityId id) const noexcept
+{
+    return activities_[id];
+}
+
+std::span<const Activity> ActivityIndex::getActivities() const noexcept
+{
+    return activities_;
+}
+
+std::size_t ActivityIndex::size() const noexcept
+{
+    return activities_.size();
+}
+
+bool ActivityIndex::hasCategory(ActivityCategory category) const noexcept
+{
+    const auto c = static_cast<std::size_t>(category);
+    return c < poolOfCategory_.size() && poolOfCategory_[c] != NO_POOL;
+}
+
+std::uint64_t ActivityIndex::getVersion() const noexcept
+{
+    return version_;
+}
+
+} // namespace domain::entities
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Activity.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace domain::entities {
+
+// Dense activity id = vị trí của activity trong catalog
+using ActivityId = std::uint32_t;
+
+// Immutable per-category index của activity catalog.
+// Activity ids được group theo category thành contiguous pools, build một lần
+// sau loadActivities() để strategies draw trong O(1) mà không cần filter/copy.
+// Pools lưu dạng structure-of-arrays: pool p là category categories_[p] với
+// ids idsByCategory_[poolOffsets_[p], poolOffsets_[p + 1]). Thứ tự pools chỉ phụ thuộc
+// catalog: built-in categories theo id, sau đó categories khác theo lần xuất hiện đầu tiên
+class ActivityIndex {
+private:
+    static constexpr std::uint32_t NO_POOL = UINT32_MAX;
+
+    std::vector<Activity> activities_;
+    std::vector<ActivityCategory> categories_;
+    std::vector<std::uint32_t> categoryKeys_;   // Activity::categoryKey() của mỗi pool
+    std::vector<std::size_t> poolOffsets_;
+    std::vector<ActivityId> idsByCategory_;
+    std::vector<std::uint32_t> poolOfCategory_; // Category id → pool, NO_POOL nếu không có
+    std::uint64_t version_ = 0;
+
+public:
+    // Constructors
+    ActivityIndex() = default;
+    explicit ActivityIndex(std::vector<Activity> activities);
+
+    // Contiguous span các activity ids thuộc category (theo thứ tự catalog); rỗng nếu
+    // catalog không có category
+    [[nodiscard]] std::span<const ActivityId> idsFor(ActivityCategory category) const noexcept;
+
+    // Categories có trong catalog, mỗi category một pool, theo thứ tự pools
+    [[nodiscard]] std::span<const ActivityCategory> getCategories() const noexcept;
+    [[nodiscard]] std::size_t categoryCount() const noexcept;
+
+    // Pool của category trong getCategories(); category phải có trong catalog
+    [[nodiscard]] std::size_t poolOf(ActivityCategory category) const noexcept;
+
+    // Activity::categoryKey() của category, precomputed; category phải có trong catalog
+    [[nodiscard]] std::uint32_t categoryKey(ActivityCategory category) const noexcept;
+
+    // Lookup activity theo id
+    [[nodiscard]] const Activity& getActivity(ActivityId id) const noexcept;
+
+    [[nodiscard]] std::span<const Activity> getActivities() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] bool hasCategory(ActivityCategory category) const noexcept;
+
+    // Unique id cho mỗi lần build, để strategies biết khi nào cần rebuild precomputed tables
+    [[nodiscard]] std::uint64_t getVersion() const noexcept;
+};
+
+} // namespace domain::entities
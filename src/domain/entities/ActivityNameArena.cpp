@@ -0,0 +1,36 @@
+#include "ActivityNameArena.h"
+#include <limits>
+#include <stdexcept>
+
+namespace domain::entities {
+
+void ActivityNameArena::reserve(std::size_t bytes)
+{
+    buffer_.reserve(bytes);
+}
+
+std::uint32_t ActivityNameArena::nextOffset(std::size_t appendBytes) const
+{
+    // Offsets và lengths là 32-bit: catalog > 4 GiB labels là lỗi, không wrap âm thầm
+    constexpr std::size_t LIMIT = std::numeric_limits<std::uint32_t>::max();
+    if (appendBytes > LIMIT - buffer_.size()) {
+        throw std::length_error("ActivityNameArena: labels exceed 4 GiB");
+    }
+    return static_cast<std::uint32_t>(buffer_.size());
+}
+
+std::uint32_t ActivityNameArena::appendLabel(std::string_view name, std::string_view categoryName)
+{
+    const auto offset = nextOffset(name.size() + categoryName.size() + 3);
+    buffer_.append(name).append(" (").append(categoryName).append(")");
+    return offset;
+}
+
+std::uint32_t ActivityNameArena::append(const ActivityNameArena& other)
+{
+    const auto offset = nextOffset(other.buffer_.size());
+    buffer_.append(other.buffer_);
+    return offset;
+}
+
+} // namespace domain::entities
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace domain::entities {
+
+// Contiguous storage cho names và labels "Name (Category)" của một catalog.
+// Repository append mọi activity vào một arena khi parse; Activities giữ offsets
+// (không giữ pointers) nên arena có thể grow trong lúc build. Sau khi build xong
+// arena được share read-only qua std::shared_ptr<const ActivityNameArena>
+class ActivityNameArena {
+private:
+    std::string buffer_;
+
+    // Offset cho appendBytes bytes tiếp theo; throw std::length_error nếu vượt UINT32_MAX
+    [[nodiscard]] std::uint32_t nextOffset(std::size_t appendBytes) const;
+
+public:
+    ActivityNameArena() = default;
+
+    // Reserve trước cho catalog khoảng `bytes` bytes labels
+    void reserve(std::size_t bytes);
+
+    // Append label "name (categoryName)"; name là prefix [offset, offset + name.size()).
+    // Append calls throw std::length_error nếu arena vượt UINT32_MAX bytes (offsets là 32-bit)
+    [[nodiscard]] std::uint32_t appendLabel(std::string_view name, std::string_view categoryName);
+
+    // Append toàn bộ arena khác (labels của một chunk được build song song); offsets
+    // trong other được dịch đi giá trị trả về
+    [[nodiscard]] std::uint32_t append(const ActivityNameArena& other);
+
+    [[nodiscard]] std::string_view view(std::uint32_t offset, std::uint32_t length) const noexcept
+    {
+        return std::string_view(buffer_).substr(offset, length);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return buffer_.size(); }
+};
+
+} // namespace domain::entities
@@ -2,10 +2,43 @@
 
 namespace domain::entities {
 
-Student::Student(std::string studentId) : id(std::move(studentId)) {}
+Student::Student(PackedId packedId) noexcept : id_(packedId) {}
 
-const std::string& Student::getId() const {
+std::optional<Student> Student::parse(std::string_view studentId) noexcept
+{
+    if (studentId.size() != ID_LENGTH) {
+        return std::nullopt;
+    }
+
+    PackedId value = 0;
+    for (char c : studentId) {
+        if (c < '0' || c > '9') {
+            return std::nullopt;
+        }
+        value = value * 10 + static_cast<PackedId>(c - '0');
+    }
+    return Student { value };
+}
+
+Student::PackedId Student::getPackedId() const noexcept
+{
+    return id_;
+}
+
+std::string Student::getId() const
+{
+    std::string id(ID_LENGTH, '0');
+    writeId(std::span<char, ID_LENGTH>(id.data(), ID_LENGTH));
     return id;
 }
 
+void Student::writeId(std::span<char, ID_LENGTH> out) const noexcept
+{
+    PackedId value = id_;
+    for (std::size_t i = ID_LENGTH; i-- > 0;) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
 } // namespace domain::entities
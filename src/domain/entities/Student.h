@@ -1,17 +1,37 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace domain::entities {
 
+// Student với packed ID: 8-digit decimal ID lưu trong uint32_t (4 bytes, không heap),
+// chỉ format lại thành 8-digit string tại output time
 class Student {
 public:
-    std::string id;
+    using PackedId = std::uint32_t;
+    static constexpr std::size_t ID_LENGTH = 8;
 
-    explicit Student(std::string studentId);
+    explicit Student(PackedId packedId) noexcept;
 
-    const std::string& getId() const;
+    // Parse 8-digit ID string; std::nullopt nếu không đúng format
+    [[nodiscard]] static std::optional<Student> parse(std::string_view studentId) noexcept;
+
+    [[nodiscard]] PackedId getPackedId() const noexcept;
+
+    // 8-digit ID string (zero-padded)
+    [[nodiscard]] std::string getId() const;
+
+    // Write 8-digit ID vào buffer của caller, không allocate
+    void writeId(std::span<char, ID_LENGTH> out) const noexcept;
 
     bool operator==(const Student& other) const = default;
+
+private:
+    PackedId id_;
 };
 
 } // namespace domain::entities
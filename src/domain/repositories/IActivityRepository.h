@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../domain/entities/Activity.h"
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <vector>
@@ -28,8 +29,14 @@ public:
     [[nodiscard]] virtual std::string getRepositoryInfo() const noexcept = 0;
 };
 
-// Factory function để tạo repository instance
+// Factory function để tạo repository instance; catalog được parse theo chunks
+// trên tối đa parseThreads workers (0 = tuần tự)
 [[nodiscard]] std::unique_ptr<IActivityRepository> createFileActivityRepository(
-    const std::string& filePath);
+    const std::string& filePath, std::size_t parseThreads = 0);
+
+// Decorator: cache parsed activities, revalidate bằng mtime/size và content hash của filePath;
+// miss parse file trên tối đa parseThreads workers
+[[nodiscard]] std::unique_ptr<IActivityRepository> createCachingActivityRepository(
+    std::unique_ptr<IActivityRepository> inner, const std::string& filePath, std::size_t parseThreads = 0);
 
 } // namespace domain::repositories
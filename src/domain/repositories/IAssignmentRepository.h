@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../../domain/entities/ActivityIndex.h"
+#include "../../domain/entities/Student.h"
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace domain::repositories {
+
+// Batch assignments để persist: students[k] được assign
+// activityIds[k * categoriesPerStudent .. (k + 1) * categoriesPerStudent)
+struct AssignmentBatch {
+    std::vector<entities::Student> students;
+    std::vector<entities::ActivityId> activityIds;
+    std::size_t categoriesPerStudent = 0;
+};
+
+// Repository interface cho assignment results (output counterpart của
+// IStudentRepository và IActivityRepository)
+class IAssignmentRepository {
+public:
+    virtual ~IAssignmentRepository() = default;
+
+    // Mở output cho một run; catalog chỉ được đọc trong open() (streaming mode
+    // destroy catalog trước close(), khi async writer có thể vẫn đang drain)
+    [[nodiscard]] virtual std::expected<void, std::string>
+    open(const entities::ActivityIndex& catalog) = 0;
+
+    // Append một batch (sink parameter: implementations có thể giữ batch)
+    [[nodiscard]] virtual std::expected<void, std::string>
+    saveAssignments(AssignmentBatch batch) = 0;
+
+    // Flush và đóng output
+    [[nodiscard]] virtual std::expected<void, std::string> close() = 0;
+
+    // Get repository info
+    [[nodiscard]] virtual std::string getRepositoryInfo() const noexcept = 0;
+};
+
+// Factory functions để tạo repository instances
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createCsvAssignmentRepository(
+    const std::string& filePath);
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createJsonLinesAssignmentRepository(
+    const std::string& filePath);
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createBinaryAssignmentRepository(
+    const std::string& filePath);
+
+// Decorator: saveAssignments() chỉ enqueue vào bounded queue, background writer thread
+// ghi vào inner repository để compute và I/O overlap
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createAsyncAssignmentRepository(
+    std::unique_ptr<IAssignmentRepository> inner, std::size_t queueCapacity);
+
+} // namespace domain::repositories
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../../domain/entities/Activity.h"
+#include "../../domain/entities/ActivityIndex.h"
+#include "../../domain/entities/Student.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace domain::repositories {
+
+// Assignments của run trước, để incremental run chỉ xử lý delta của roster.
+// studentIds sorted ascending (unique); student studentIds[k] có
+// activityIds[k * categoriesPerStudent .. (k + 1) * categoriesPerStudent),
+// là indices vào `activities` (catalog của run trước)
+struct AssignmentState {
+    std::vector<entities::Activity> activities;
+    std::vector<entities::Student::PackedId> studentIds;
+    std::vector<entities::ActivityId> activityIds;
+    std::size_t categoriesPerStudent = 0;
+
+    // Số draw counters đã dùng; students mới draw từ counter này trở đi
+    std::uint64_t drawCount = 0;
+};
+
+// Repository interface cho persisted assignment state
+class IAssignmentStateRepository {
+public:
+    virtual ~IAssignmentStateRepository() = default;
+
+    // State chưa tồn tại thì trả về empty state
+    [[nodiscard]] virtual std::expected<AssignmentState, std::string> loadState() const = 0;
+
+    // Replace state; implementations không để lại state ghi dở khi fail
+    [[nodiscard]] virtual std::expected<void, std::string> saveState(const AssignmentState& state) = 0;
+
+    // Get repository info
+    [[nodiscard]] virtual std::string getRepositoryInfo() const noexcept = 0;
+};
+
+// Factory function để tạo repository instance
+[[nodiscard]] std::unique_ptr<IAssignmentStateRepository> createFileAssignmentStateRepository(
+    const std::string& filePath);
+
+} // namespace domain::repositories
@@ -1,17 +1,11 @@
 #pragma once
 
 #include "../../domain/entities/Student.h"
-#include <expected>
-#include <memory>
-#include <vector>
-#include <string>
-
-namespace domain::repositories {
-
-#pragma once
-
-#include "../../domain/entities/Student.h"
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <string>
 #include <optional>
@@ -23,9 +17,36 @@ class IStudentRepository {
 public:
     virtual ~IStudentRepository() = default;
 
-    // Load students với std::optional for error handling
-    [[nodiscard]] virtual std::optional<std::vector<entities::Student>>
-    loadStudents() const = 0;
+    // Roster allocate từ memory resource của caller (vd. run arena của service)
+    using StudentList = std::pmr::vector<entities::Student>;
+
+    // Load students với std::optional for error handling; roster dùng resource
+    [[nodiscard]] virtual std::optional<StudentList>
+    loadStudents(std::pmr::memory_resource* resource) const = 0;
+
+    // Roster read-only có thể chia sẻ giữa các runs (vd. cache của daemon) mà không copy
+    using SharedStudentList = std::shared_ptr<const StudentList>;
+
+    // Load roster dưới dạng shared handle; nullptr khi có lỗi. Default move kết quả của
+    // loadStudents(resource) vào handle; decorators có thể trả roster nằm ngoài resource
+    [[nodiscard]] virtual SharedStudentList
+    loadSharedStudents(std::pmr::memory_resource* resource) const
+    {
+        auto students = loadStudents(resource);
+        if (!students) {
+            return nullptr;
+        }
+        return std::make_shared<const StudentList>(std::move(*students));
+    }
+
+    // Consumer nhận từng chunk students; return false để dừng sớm
+    using StudentChunkConsumer = std::function<bool(std::span<const entities::Student>)>;
+
+    // Stream students theo chunks tối đa chunkSize, chỉ giữ một chunk trong memory
+    // (chunk buffer allocate từ resource). Returns false khi có lỗi đọc hoặc consumer dừng sớm
+    [[nodiscard]] virtual bool
+    streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+        std::pmr::memory_resource* resource) const = 0;
 
     // Save students (returns false on error)
     [[nodiscard]] virtual bool
@@ -38,32 +59,19 @@ public:
     [[nodiscard]] virtual std::string getRepositoryInfo() const noexcept = 0;
 };
 
-// Factory function để tạo repository instance
+// Factory function để tạo repository instance; std::getline loader tuần tự, giữ làm
+// reference cho mmap loader
 [[nodiscard]] std::unique_ptr<IStudentRepository> createFileStudentRepository(
     const std::string& filePath);
 
-} // namespace domain::repositories
-class IStudentRepository {
-public:
-    virtual ~IStudentRepository() = default;
-
-    // Load students với std::expected
-    [[nodiscard]] virtual std::expected<std::vector<entities::Student>, std::string>
-    loadStudents() const = 0;
-
-    // Save students với std::expected
-    [[nodiscard]] virtual std::expected<void, std::string>
-    saveStudents(const std::vector<entities::Student>& students) const = 0;
-
-    // Check if repository is available
-    [[nodiscard]] virtual bool isAvailable() const noexcept = 0;
+// Memory-mapped variant cho large rosters; loadStudents() parse file theo chunks trên
+// tối đa parseThreads workers (0 = tuần tự)
+[[nodiscard]] std::unique_ptr<IStudentRepository> createMappedStudentRepository(
+    const std::string& filePath, std::size_t parseThreads = 0);
 
-    // Get repository info
-    [[nodiscard]] virtual std::string getRepositoryInfo() const noexcept = 0;
-};
-
-// Factory function để tạo repository instance
-[[nodiscard]] std::unique_ptr<IStudentRepository> createFileStudentRepository(
-    const std::string& filePath);
+// Decorator: cache parsed roster, revalidate bằng mtime/size và content hash của filePath;
+// miss parse file trên tối đa parseThreads workers
+[[nodiscard]] std::unique_ptr<IStudentRepository> createCachingStudentRepository(
+    std::unique_ptr<IStudentRepository> inner, const std::string& filePath, std::size_t parseThreads = 0);
 
 } // namespace domain::repositories
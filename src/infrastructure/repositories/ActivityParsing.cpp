@@ -0,0 +1,202 @@
+#include "ActivityParsing.h"
+#include "../utils/LineChunks.h"
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace infrastructure::repositories {
+
+namespace {
+
+[[nodiscard]] std::string_view trim(std::string_view text, std::string_view characters) noexcept
+{
+    const auto first = text.find_first_not_of(characters);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(characters) - first + 1);
+}
+
+// Một dòng hợp lệ về format; categoryName trỏ vào file contents, label nằm trong
+// arena của chunk
+struct ParsedActivity {
+    std::size_t line; // Số dòng trong chunk, từ 1
+    std::string_view categoryName;
+    std::optional<domain::entities::ActivityCategory> category; // nullopt: chưa intern
+    std::uint32_t capacity;
+    std::uint32_t labelOffset; // Trong ActivityChunk::labels
+    std::uint32_t nameLength;
+    std::uint32_t labelLength;
+};
+
+// Lỗi đầu tiên của một chunk; parse dừng tại dòng này
+struct ParseError {
+    std::size_t line;
+    std::string_view message;
+    std::string_view value;
+    std::optional<std::string_view> categoryName; // Có với lỗi capacity
+};
+
+struct ActivityChunk {
+    std::vector<ParsedActivity> activities;
+    domain::entities::ActivityNameArena labels; // Labels "Name (Category)" của chunk
+    std::size_t lineCount = 0;
+    std::optional<ParseError> error;
+};
+
+[[nodiscard]] std::string lineError(std::string_view message, std::size_t line, std::string_view value)
+{
+    std::string error(message);
+    error.append(" in line ").append(std::to_string(line)).append(": ").append(value);
+    return error;
+}
+
+// Parse một chunk "ActivityName,Category[,Capacity]" lines và build labels vào arena
+// của chunk. Chạy trên worker: chỉ lookup categories đã intern (cache per chunk), không
+// register category mới
+[[nodiscard]] ActivityChunk parseChunk(std::string_view text)
+{
+    ActivityChunk chunk;
+    // Label dài hơn line khoảng " (" + ")" nên reserve theo chunk size là đủ cho đa số catalogs
+    chunk.labels.reserve(text.size() + text.size() / 2);
+    std::unordered_map<std::string_view, domain::entities::ActivityCategory> categories;
+
+    std::size_t position = 0;
+    while (position < text.size()) {
+        const auto newline = text.find('\n', position);
+        const auto lineEnd = newline == std::string_view::npos ? text.size() : newline;
+        const auto line = trim(text.substr(position, lineEnd - position), " \t\r\n");
+        position = lineEnd + 1;
+        const std::size_t lineNumber = ++chunk.lineCount;
+
+        if (line.empty()) {
+            continue;
+        }
+
+        const auto commaPos = line.find(',');
+        if (commaPos == std::string_view::npos) {
+            chunk.error = ParseError { lineNumber, "Invalid format", line, std::nullopt };
+            return chunk;
+        }
+
+        const auto name = trim(line.substr(0, commaPos), " \t");
+        auto categoryName = line.substr(commaPos + 1);
+        std::optional<std::string_view> capacityText;
+        if (const auto capacityPos = categoryName.find(','); capacityPos != std::string_view::npos) {
+            capacityText = trim(categoryName.substr(capacityPos + 1), " \t");
+            categoryName = categoryName.substr(0, capacityPos);
+        }
+        categoryName = trim(categoryName, " \t");
+
+        // Optional seat limit
+        auto capacity = domain::entities::Activity::UNLIMITED_CAPACITY;
+        if (capacityText) {
+            const char* end = capacityText->data() + capacityText->size();
+            auto [ptr, ec] = std::from_chars(capacityText->data(), end, capacity);
+            if (ec != std::errc {} || ptr != end || capacity == domain::entities::Activity::UNLIMITED_CAPACITY) {
+                chunk.error = ParseError { lineNumber, "Invalid capacity", *capacityText, categoryName };
+                return chunk;
+            }
+        }
+
+        std::optional<domain::entities::ActivityCategory> category;
+        if (auto it = categories.find(categoryName); it != categories.end()) {
+            category = it->second;
+        } else if ((category = domain::entities::Activity::stringToCategory(categoryName))) {
+            categories.emplace(categoryName, *category);
+        }
+
+        // Label theo category name trong file, giống categoryToString() của id được intern
+        const auto labelOffset = chunk.labels.appendLabel(name, categoryName);
+        chunk.activities.push_back({ lineNumber, categoryName, category, capacity, labelOffset,
+            static_cast<std::uint32_t>(name.size()),
+            static_cast<std::uint32_t>(chunk.labels.size() - labelOffset) });
+    }
+    return chunk;
+}
+
+} // namespace
+
+std::expected<std::vector<domain::entities::Activity>, std::string>
+parseActivities(std::string_view contents, std::size_t parseThreads)
+{
+    // Parse và build labels song song theo chunks; merge tuần tự theo thứ tự file chỉ
+    // append arenas và intern categories mới, để category ids (và lỗi được report) giống
+    // hệt parse tuần tự
+    const auto chunks = utils::splitAtNewlines(contents, parseThreads);
+    std::vector<ActivityChunk> parsed(chunks.size());
+    std::vector<std::exception_ptr> failures(chunks.size());
+    utils::runChunks(chunks.size(), [&](std::size_t i) {
+        try {
+            parsed[i] = parseChunk(chunks[i]);
+        } catch (...) {
+            failures[i] = std::current_exception();
+        }
+    });
+    for (const auto& failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    // Names + labels của cả catalog trong một arena: một copy mỗi chunk
+    std::size_t activityCount = 0;
+    std::size_t labelBytes = 0;
+    for (const auto& chunk : parsed) {
+        activityCount += chunk.activities.size();
+        labelBytes += chunk.labels.size();
+    }
+    auto arena = std::make_shared<domain::entities::ActivityNameArena>();
+    arena->reserve(labelBytes);
+    std::vector<std::uint32_t> labelBases;
+    labelBases.reserve(parsed.size());
+    for (const auto& chunk : parsed) {
+        labelBases.push_back(arena->append(chunk.labels));
+    }
+    const std::shared_ptr<const domain::entities::ActivityNameArena> labels = std::move(arena);
+
+    std::vector<domain::entities::Activity> activities;
+    activities.reserve(activityCount);
+
+    // Categories chưa có lúc workers chạy, intern một lần mỗi name
+    std::unordered_map<std::string_view, domain::entities::ActivityCategory> newCategories;
+    auto internNew = [&](std::string_view categoryName) -> std::optional<domain::entities::ActivityCategory> {
+        if (auto it = newCategories.find(categoryName); it != newCategories.end()) {
+            return it->second;
+        }
+        auto category = domain::entities::Activity::internCategory(categoryName);
+        if (category) {
+            newCategories.emplace(categoryName, *category);
+        }
+        return category;
+    };
+
+    std::size_t linesBefore = 0;
+    for (std::size_t c = 0; c < parsed.size(); ++c) {
+        const auto& chunk = parsed[c];
+        for (const auto& activity : chunk.activities) {
+            const auto category = activity.category ? activity.category : internNew(activity.categoryName);
+            if (!category) {
+                return std::unexpected(lineError("Invalid category", linesBefore + activity.line, activity.categoryName));
+            }
+            activities.emplace_back(labels, labelBases[c] + activity.labelOffset, activity.nameLength,
+                activity.labelLength, *category, activity.capacity);
+        }
+
+        if (const auto& error = chunk.error) {
+            // Dòng lỗi capacity: category được intern (và validate) trước, như parse tuần tự
+            if (error->categoryName && !internNew(*error->categoryName)) {
+                return std::unexpected(lineError("Invalid category", linesBefore + error->line, *error->categoryName));
+            }
+            return std::unexpected(lineError(error->message, linesBefore + error->line, error->value));
+        }
+        linesBefore += chunk.lineCount;
+    }
+
+    return activities;
+}
+
+} // namespace infrastructure::repositories
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "../../domain/entities/Activity.h"
+#include <cstddef>
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// Parse catalog "ActivityName,Category[,Capacity]" lines theo chunks tại newline boundaries
+// trên tối đa parseThreads workers (0 hoặc 1 = tuần tự). Categories mới được intern theo
+// thứ tự file; lỗi đầu tiên được report kèm số dòng ("Invalid capacity in line 42: abc")
+[[nodiscard]] std::expected<std::vector<domain::entities::Activity>, std::string>
+parseActivities(std::string_view contents, std::size_t parseThreads);
+
+} // namespace infrastructure::repositories
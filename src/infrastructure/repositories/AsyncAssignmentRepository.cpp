@@ -0,0 +1,110 @@
+#include "AsyncAssignmentRepository.h"
+#include <utility>
+
+namespace infrastructure::repositories {
+
+AsyncAssignmentRepository::AsyncAssignmentRepository(
+    std::unique_ptr<domain::repositories::IAssignmentRepository> inner,
+    std::size_t queueCapacity)
+    : inner_(std::move(inner))
+    , queueCapacity_(queueCapacity)
+{
+}
+
+AsyncAssignmentRepository::~AsyncAssignmentRepository()
+{
+    (void)close();
+}
+
+std::expected<void, std::string>
+AsyncAssignmentRepository::open(const domain::entities::ActivityIndex& catalog)
+{
+    // open() lần hai: drain và join writer cũ trước khi thay queue_
+    if (auto closed = close(); !closed) {
+        return closed;
+    }
+
+    if (auto opened = inner_->open(catalog); !opened) {
+        return opened;
+    }
+
+    queue_ = std::make_unique<utils::BoundedQueue<domain::repositories::AssignmentBatch>>(queueCapacity_);
+    writer_ = std::jthread([this] { runWriter(); });
+    return {};
+}
+
+void AsyncAssignmentRepository::runWriter()
+{
+    // Drain queue tới khi close(); sau lỗi đầu tiên vẫn drain để producer không bị block
+    bool failed = false;
+    while (auto batch = queue_->pop()) {
+        if (failed) {
+            continue;
+        }
+        if (auto saved = inner_->saveAssignments(std::move(*batch)); !saved) {
+            std::lock_guard lock(errorMutex_);
+            error_ = saved.error();
+            failed = true;
+        }
+    }
+}
+
+std::optional<std::string> AsyncAssignmentRepository::takeError()
+{
+    std::lock_guard lock(errorMutex_);
+    return std::exchange(error_, std::nullopt);
+}
+
+std::expected<void, std::string>
+AsyncAssignmentRepository::saveAssignments(domain::repositories::AssignmentBatch batch)
+{
+    if (!queue_) {
+        return std::unexpected("Repository not open: " + inner_->getRepositoryInfo());
+    }
+    if (auto error = takeError()) {
+        return std::unexpected(*error);
+    }
+    if (!queue_->push(std::move(batch))) {
+        return std::unexpected("Repository closed: " + inner_->getRepositoryInfo());
+    }
+    return {};
+}
+
+std::expected<void, std::string> AsyncAssignmentRepository::close()
+{
+    if (!queue_) {
+        return {};
+    }
+
+    // Cho writer drain phần còn lại rồi join
+    queue_->close();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    queue_.reset();
+
+    auto closed = inner_->close();
+    if (auto error = takeError()) {
+        return std::unexpected(*error);
+    }
+    return closed;
+}
+
+std::string AsyncAssignmentRepository::getRepositoryInfo() const noexcept
+{
+    return "AsyncAssignmentRepository(" + inner_->getRepositoryInfo() + ")";
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IAssignmentRepository> createAsyncAssignmentRepository(
+    std::unique_ptr<IAssignmentRepository> inner, std::size_t queueCapacity)
+{
+    return std::make_unique<infrastructure::repositories::AsyncAssignmentRepository>(
+        std::move(inner), queueCapacity);
+}
+
+} // namespace domain::repositories
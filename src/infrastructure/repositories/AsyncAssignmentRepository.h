@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../../domain/repositories/IAssignmentRepository.h"
+#include "../utils/BoundedQueue.h"
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace infrastructure::repositories {
+
+// Decorator chạy inner repository trên background writer thread.
+// saveAssignments() chỉ push batch vào bounded queue (block khi queue đầy),
+// nên assignment computation và output I/O overlap
+class AsyncAssignmentRepository : public domain::repositories::IAssignmentRepository {
+private:
+    std::unique_ptr<domain::repositories::IAssignmentRepository> inner_;
+    std::size_t queueCapacity_;
+    std::unique_ptr<utils::BoundedQueue<domain::repositories::AssignmentBatch>> queue_;
+    std::jthread writer_;
+
+    // Lỗi đầu tiên của writer thread, report ở call tiếp theo
+    mutable std::mutex errorMutex_;
+    std::optional<std::string> error_;
+
+    void runWriter();
+    [[nodiscard]] std::optional<std::string> takeError();
+
+public:
+    AsyncAssignmentRepository(
+        std::unique_ptr<domain::repositories::IAssignmentRepository> inner,
+        std::size_t queueCapacity);
+    ~AsyncAssignmentRepository() override;
+
+    // Nếu đang open thì close() (drain, join writer) trước khi open lại
+    [[nodiscard]] std::expected<void, std::string>
+    open(const domain::entities::ActivityIndex& catalog) override;
+
+    [[nodiscard]] std::expected<void, std::string>
+    saveAssignments(domain::repositories::AssignmentBatch batch) override;
+
+    [[nodiscard]] std::expected<void, std::string> close() override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createAsyncAssignmentRepository(
+    std::unique_ptr<IAssignmentRepository> inner, std::size_t queueCapacity);
+
+} // namespace domain::repositories
@@ -0,0 +1,141 @@
+#include "BinaryAssignmentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include <cstdint>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+namespace {
+
+// File layout (little-endian):
+//   header: "SAAB", u32 version,
+//           u32 categoryCount, categoryCount x { u32 nameLength, name bytes },
+//           u32 activityCount, activityCount x { u32 category, u32 nameLength, name bytes }
+//   blocks: u32 studentCount, u32 categoriesPerStudent,
+//           studentCount x { u32 packedStudentId, categoriesPerStudent x u32 activityId }
+// Category của activity là index vào category table của header, để reader resolve
+// category bằng tên thay vì interned id của process đã ghi file
+constexpr std::string_view MAGIC = "SAAB";
+constexpr std::uint32_t FORMAT_VERSION = 2;
+
+void appendU32(std::string& out, std::uint32_t value)
+{
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 24) & 0xFF);
+}
+
+} // namespace
+
+BinaryAssignmentRepository::BinaryAssignmentRepository(std::string filePath)
+    : filePath_(std::move(filePath))
+{
+}
+
+std::expected<void, std::string>
+BinaryAssignmentRepository::open(const domain::entities::ActivityIndex& catalog)
+{
+    file_.open(filePath_, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return std::unexpected("Permission denied: " + filePath_);
+    }
+
+    // Catalog table để file tự mô tả activity ids
+    buffer_.assign(MAGIC);
+    appendU32(buffer_, FORMAT_VERSION);
+
+    // Category table theo thứ tự xuất hiện đầu tiên trong catalog
+    std::vector<domain::entities::ActivityCategory> categories;
+    std::vector<std::uint32_t> fileCategoryOf;
+    for (const auto& activity : catalog.getActivities()) {
+        const auto id = static_cast<std::size_t>(activity.getCategory());
+        if (id >= fileCategoryOf.size()) {
+            fileCategoryOf.resize(id + 1, UINT32_MAX);
+        }
+        if (fileCategoryOf[id] == UINT32_MAX) {
+            fileCategoryOf[id] = static_cast<std::uint32_t>(categories.size());
+            categories.push_back(activity.getCategory());
+        }
+    }
+    appendU32(buffer_, static_cast<std::uint32_t>(categories.size()));
+    for (auto category : categories) {
+        const auto name = domain::entities::Activity::categoryToString(category);
+        appendU32(buffer_, static_cast<std::uint32_t>(name.size()));
+        buffer_ += name;
+    }
+
+    appendU32(buffer_, static_cast<std::uint32_t>(catalog.size()));
+    for (const auto& activity : catalog.getActivities()) {
+        appendU32(buffer_, fileCategoryOf[static_cast<std::size_t>(activity.getCategory())]);
+        appendU32(buffer_, static_cast<std::uint32_t>(activity.getName().size()));
+        buffer_ += activity.getName();
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    application::services::recordBytesWritten(buffer_.size());
+    if (file_.bad()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::expected<void, std::string>
+BinaryAssignmentRepository::saveAssignments(domain::repositories::AssignmentBatch batch)
+{
+    if (!file_.is_open()) {
+        return std::unexpected("Repository not open: " + filePath_);
+    }
+
+    buffer_.clear();
+    buffer_.reserve(8 + batch.students.size() * 4 + batch.activityIds.size() * 4);
+
+    const std::size_t stride = batch.categoriesPerStudent;
+    appendU32(buffer_, static_cast<std::uint32_t>(batch.students.size()));
+    appendU32(buffer_, static_cast<std::uint32_t>(stride));
+
+    for (std::size_t k = 0; k < batch.students.size(); ++k) {
+        appendU32(buffer_, batch.students[k].getPackedId());
+        for (std::size_t c = 0; c < stride; ++c) {
+            appendU32(buffer_, batch.activityIds[k * stride + c]);
+        }
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    application::services::recordBytesWritten(buffer_.size());
+    if (file_.bad()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::expected<void, std::string> BinaryAssignmentRepository::close()
+{
+    if (!file_.is_open()) {
+        return {};
+    }
+
+    file_.close();
+    if (file_.fail()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::string BinaryAssignmentRepository::getRepositoryInfo() const noexcept
+{
+    return "BinaryAssignmentRepository: " + filePath_;
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IAssignmentRepository> createBinaryAssignmentRepository(
+    const std::string& filePath)
+{
+    return std::make_unique<infrastructure::repositories::BinaryAssignmentRepository>(filePath);
+}
+
+} // namespace domain::repositories
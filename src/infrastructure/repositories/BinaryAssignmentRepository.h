@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../../domain/repositories/IAssignmentRepository.h"
+#include <expected>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// compact binary Assignment Repository implementation
+class BinaryAssignmentRepository : public domain::repositories::IAssignmentRepository {
+private:
+    std::string filePath_;
+    std::ofstream file_;
+
+    std::string buffer_;
+public:
+    explicit BinaryAssignmentRepository(std::string filePath);
+
+    [[nodiscard]] std::expected<void, std::string>
+    open(const domain::entities::ActivityIndex& catalog) override;
+
+    [[nodiscard]] std::expected<void, std::string>
+    saveAssignments(domain::repositories::AssignmentBatch batch) override;
+
+    [[nodiscard]] std::expected<void, std::string> close() override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createBinaryAssignmentRepository(
+    const std::string& filePath);
+
+} // namespace domain::repositories
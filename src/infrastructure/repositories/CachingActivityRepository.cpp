@@ -0,0 +1,85 @@
+#include "CachingActivityRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "ActivityParsing.h"
+#include "../utils/MappedFile.h"
+
+namespace infrastructure::repositories {
+
+CachingActivityRepository::CachingActivityRepository(
+    std::unique_ptr<domain::repositories::IActivityRepository> inner, std::string filePath, std::size_t parseThreads)
+    : inner_(std::move(inner))
+    , filePath_(std::move(filePath))
+    , parseThreads_(parseThreads)
+{
+}
+
+std::expected<std::vector<domain::entities::Activity>, std::string>
+CachingActivityRepository::loadActivities() const
+{
+    std::lock_guard lock(mutex_);
+
+    // Fast path: stamp không đổi
+    auto stamp = utils::statFile(filePath_);
+    if (fingerprint_ && stamp && *stamp == fingerprint_->stamp) {
+        return activities_;
+    }
+
+    // File không stat/map được (FIFO, không tồn tại): không cache, inner report lỗi
+    auto file = stamp ? utils::MappedFile::open(filePath_) : std::nullopt;
+    if (!file) {
+        fingerprint_.reset();
+        return inner_->loadActivities();
+    }
+    application::services::recordBytesRead(file->size());
+
+    // Hash và parse cùng một mapping: mỗi miss chỉ đọc file một lần.
+    // Stamp đổi nhưng contents giống hệt (vd. touch): chỉ cập nhật stamp
+    const utils::FileFingerprint fingerprint { .stamp = *stamp, .contentHash = utils::hashContents(file->contents()) };
+    if (fingerprint_ && fingerprint.contentHash == fingerprint_->contentHash) {
+        fingerprint_ = fingerprint;
+        return activities_;
+    }
+
+    auto activities = parseActivities(file->contents(), parseThreads_);
+    if (!activities) {
+        fingerprint_.reset();
+        return activities;
+    }
+
+    activities_ = *activities;
+    fingerprint_ = fingerprint;
+    return activities;
+}
+
+std::expected<void, std::string>
+CachingActivityRepository::saveActivities(const std::vector<domain::entities::Activity>& activities) const
+{
+    std::lock_guard lock(mutex_);
+    fingerprint_.reset();
+    activities_.clear();
+    return inner_->saveActivities(activities);
+}
+
+bool CachingActivityRepository::isAvailable() const noexcept
+{
+    return inner_->isAvailable();
+}
+
+std::string CachingActivityRepository::getRepositoryInfo() const noexcept
+{
+    return "CachingActivityRepository(" + inner_->getRepositoryInfo() + ")";
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IActivityRepository> createCachingActivityRepository(
+    std::unique_ptr<IActivityRepository> inner, const std::string& filePath, std::size_t parseThreads)
+{
+    return std::make_unique<infrastructure::repositories::CachingActivityRepository>(
+        std::move(inner), filePath, parseThreads);
+}
+
+} // namespace domain::repositories
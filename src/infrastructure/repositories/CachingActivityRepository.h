@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../../domain/repositories/IActivityRepository.h"
+#include "../utils/FileFingerprint.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// Decorator: giữ activities đã parse, revalidate bằng stat (mtime/size) và content hash.
+// Load lặp lại với file không đổi chỉ tốn một stat; khi stat đổi, file được map một lần,
+// hash rồi parse (parseActivities) từ chính mapping đó. Inner repository dùng cho saves
+// và files không map được
+class CachingActivityRepository : public domain::repositories::IActivityRepository {
+private:
+    std::unique_ptr<domain::repositories::IActivityRepository> inner_;
+    std::string filePath_;
+    std::size_t parseThreads_;
+
+    // Cache được guard bởi mutex_ vì load là const và có thể gọi từ nhiều threads
+    mutable std::mutex mutex_;
+    mutable std::optional<utils::FileFingerprint> fingerprint_;
+    mutable std::vector<domain::entities::Activity> activities_;
+
+public:
+    // parseThreads: số workers tối đa khi parse mapping (0 hoặc 1 = tuần tự)
+    CachingActivityRepository(std::unique_ptr<domain::repositories::IActivityRepository> inner,
+        std::string filePath, std::size_t parseThreads = 0);
+
+    [[nodiscard]] std::expected<std::vector<domain::entities::Activity>, std::string>
+    loadActivities() const override;
+
+    // Save qua inner repository và invalidate cache
+    [[nodiscard]] std::expected<void, std::string>
+    saveActivities(const std::vector<domain::entities::Activity>& activities) const override;
+
+    [[nodiscard]] bool isAvailable() const noexcept override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IActivityRepository> createCachingActivityRepository(
+    std::unique_ptr<IActivityRepository> inner, const std::string& filePath, std::size_t parseThreads);
+
+} // namespace domain::repositories
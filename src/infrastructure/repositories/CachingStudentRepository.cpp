@@ -0,0 +1,109 @@
+#include "CachingStudentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "StudentParsing.h"
+#include "../utils/MappedFile.h"
+
+namespace infrastructure::repositories {
+
+CachingStudentRepository::CachingStudentRepository(
+    std::unique_ptr<domain::repositories::IStudentRepository> inner, std::string filePath, std::size_t parseThreads)
+    : inner_(std::move(inner))
+    , filePath_(std::move(filePath))
+    , parseThreads_(parseThreads)
+{
+}
+
+domain::repositories::IStudentRepository::SharedStudentList CachingStudentRepository::refresh() const
+{
+    // Fast path: stamp không đổi
+    auto stamp = utils::statFile(filePath_);
+    if (fingerprint_ && stamp && *stamp == fingerprint_->stamp) {
+        return students_;
+    }
+
+    // File không stat/map được (FIFO, không tồn tại): không cache, inner report lỗi
+    auto file = stamp ? utils::MappedFile::open(filePath_) : std::nullopt;
+    if (!file) {
+        fingerprint_.reset();
+        students_.reset();
+        return nullptr;
+    }
+    application::services::recordBytesRead(file->size());
+
+    // Hash và parse cùng một mapping: mỗi miss chỉ đọc file một lần.
+    // Stamp đổi nhưng contents giống hệt (vd. touch): chỉ cập nhật stamp
+    const utils::FileFingerprint fingerprint { .stamp = *stamp, .contentHash = utils::hashContents(file->contents()) };
+    if (fingerprint_ && fingerprint.contentHash == fingerprint_->contentHash) {
+        fingerprint_ = fingerprint;
+        return students_;
+    }
+
+    // Cache nằm trên default heap (outlive các runs); handles cũ vẫn giữ roster cũ
+    StudentList students;
+    // Ước lượng một ID (8 digits + newline) mỗi dòng
+    students.reserve(file->size() / (domain::entities::Student::ID_LENGTH + 1) + 1);
+    appendStudents(file->contents(), parseThreads_, students);
+
+    students_ = std::make_shared<const StudentList>(std::move(students));
+    fingerprint_ = fingerprint;
+    return students_;
+}
+
+std::optional<domain::repositories::IStudentRepository::StudentList>
+CachingStudentRepository::loadStudents(std::pmr::memory_resource* resource) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto cached = refresh()) {
+        // Caller sở hữu list nên nhận copy trong resource
+        return StudentList(cached->begin(), cached->end(), resource);
+    }
+    return inner_->loadStudents(resource);
+}
+
+domain::repositories::IStudentRepository::SharedStudentList
+CachingStudentRepository::loadSharedStudents(std::pmr::memory_resource* resource) const
+{
+    std::lock_guard lock(mutex_);
+    if (auto cached = refresh()) {
+        return cached;
+    }
+    return inner_->loadSharedStudents(resource);
+}
+
+bool CachingStudentRepository::streamStudents(
+    std::size_t chunkSize, const StudentChunkConsumer& consumer, std::pmr::memory_resource* resource) const
+{
+    return inner_->streamStudents(chunkSize, consumer, resource);
+}
+
+bool CachingStudentRepository::saveStudents(const std::vector<domain::entities::Student>& students) const
+{
+    std::lock_guard lock(mutex_);
+    fingerprint_.reset();
+    students_.reset();
+    return inner_->saveStudents(students);
+}
+
+bool CachingStudentRepository::isAvailable() const noexcept
+{
+    return inner_->isAvailable();
+}
+
+std::string CachingStudentRepository::getRepositoryInfo() const noexcept
+{
+    return "CachingStudentRepository(" + inner_->getRepositoryInfo() + ")";
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IStudentRepository> createCachingStudentRepository(
+    std::unique_ptr<IStudentRepository> inner, const std::string& filePath, std::size_t parseThreads)
+{
+    return std::make_unique<infrastructure::repositories::CachingStudentRepository>(
+        std::move(inner), filePath, parseThreads);
+}
+
+} // namespace domain::repositories
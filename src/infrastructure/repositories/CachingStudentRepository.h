@@ -0,0 +1,68 @@
+#pragma once
+
+#include "../../domain/repositories/IStudentRepository.h"
+#include "../utils/FileFingerprint.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// Decorator: giữ roster đã parse, revalidate bằng stat (mtime/size) và content hash.
+// Load lặp lại với file không đổi chỉ tốn một stat: loadSharedStudents trả chính roster
+// đã cache, loadStudents copy packed IDs vào resource của caller. Khi stat đổi,
+// file được map một lần, hash rồi parse (appendStudents) từ chính mapping đó.
+// Inner repository dùng cho streaming, saves và files không map được
+class CachingStudentRepository : public domain::repositories::IStudentRepository {
+private:
+    std::unique_ptr<domain::repositories::IStudentRepository> inner_;
+    std::string filePath_;
+    std::size_t parseThreads_;
+
+    // Cache được guard bởi mutex_ vì load là const và có thể gọi từ nhiều threads
+    mutable std::mutex mutex_;
+    mutable std::optional<utils::FileFingerprint> fingerprint_;
+    mutable SharedStudentList students_;
+
+    // Revalidate cache (caller giữ mutex_); nullptr nếu file không map được và
+    // load phải delegate tới inner
+    [[nodiscard]] SharedStudentList refresh() const;
+
+public:
+    // parseThreads: số workers tối đa khi parse mapping (0 hoặc 1 = tuần tự)
+    CachingStudentRepository(std::unique_ptr<domain::repositories::IStudentRepository> inner,
+        std::string filePath, std::size_t parseThreads = 0);
+
+    [[nodiscard]] std::optional<StudentList>
+    loadStudents(std::pmr::memory_resource* resource) const override;
+
+    // Cache hit không copy: handle trỏ tới roster đã cache (trên default heap)
+    [[nodiscard]] SharedStudentList
+    loadSharedStudents(std::pmr::memory_resource* resource) const override;
+
+    // Streaming không cache (mục đích là memory bounded), delegate thẳng tới inner
+    [[nodiscard]] bool
+    streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+        std::pmr::memory_resource* resource) const override;
+
+    // Save qua inner repository và invalidate cache
+    [[nodiscard]] bool
+    saveStudents(const std::vector<domain::entities::Student>& students) const override;
+
+    [[nodiscard]] bool isAvailable() const noexcept override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IStudentRepository> createCachingStudentRepository(
+    std::unique_ptr<IStudentRepository> inner, const std::string& filePath, std::size_t parseThreads);
+
+} // namespace domain::repositories
@@ -0,0 +1,128 @@
+#include "CsvAssignmentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include <array>
+#include <string_view>
+
+namespace infrastructure::repositories {
+
+namespace {
+
+// Quote field nếu chứa separator, quote hoặc newline (RFC 4180)
+[[nodiscard]] std::string escapeCsv(std::string_view value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return std::string(value);
+    }
+
+    std::string escaped = "\"";
+    for (char c : value) {
+        if (c == '"') {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    escaped += '"';
+    return escaped;
+}
+
+} // namespace
+
+CsvAssignmentRepository::CsvAssignmentRepository(std::string filePath)
+    : filePath_(std::move(filePath))
+{
+}
+
+std::expected<void, std::string>
+CsvAssignmentRepository::open(const domain::entities::ActivityIndex& catalog)
+{
+    file_.open(filePath_, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return std::unexpected("Permission denied: " + filePath_);
+    }
+
+    headerWritten_ = false;
+    fields_.clear();
+    fields_.reserve(catalog.size());
+    categories_.clear();
+    categories_.reserve(catalog.size());
+    for (const auto& activity : catalog.getActivities()) {
+        fields_.push_back(escapeCsv(activity.getName()));
+        categories_.push_back(activity.getCategory());
+    }
+    return {};
+}
+
+std::expected<void, std::string>
+CsvAssignmentRepository::saveAssignments(domain::repositories::AssignmentBatch batch)
+{
+    if (!file_.is_open()) {
+        return std::unexpected("Repository not open: " + filePath_);
+    }
+
+    buffer_.clear();
+    const std::size_t stride = batch.categoriesPerStudent;
+
+    // Header lấy category names từ row đầu tiên: mỗi column là một category
+    if (!headerWritten_ && !batch.students.empty()) {
+        buffer_ += "student_id";
+        for (std::size_t c = 0; c < stride; ++c) {
+            buffer_ += ',';
+            buffer_ += escapeCsv(domain::entities::Activity::categoryToString(
+                categories_[batch.activityIds[c]]));
+        }
+        buffer_ += '\n';
+        headerWritten_ = true;
+    }
+
+    std::array<char, domain::entities::Student::ID_LENGTH> id {};
+    for (std::size_t k = 0; k < batch.students.size(); ++k) {
+        batch.students[k].writeId(id);
+        buffer_.append(id.data(), id.size());
+        for (std::size_t c = 0; c < stride; ++c) {
+            buffer_ += ',';
+            buffer_ += fields_[batch.activityIds[k * stride + c]];
+        }
+        buffer_ += '\n';
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    application::services::recordBytesWritten(buffer_.size());
+    if (file_.bad()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::expected<void, std::string> CsvAssignmentRepository::close()
+{
+    if (!file_.is_open()) {
+        return {};
+    }
+
+    if (!headerWritten_) {
+        file_ << "student_id\n";
+    }
+    file_.close();
+    if (file_.fail()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::string CsvAssignmentRepository::getRepositoryInfo() const noexcept
+{
+    return "CsvAssignmentRepository: " + filePath_;
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IAssignmentRepository> createCsvAssignmentRepository(
+    const std::string& filePath)
+{
+    return std::make_unique<infrastructure::repositories::CsvAssignmentRepository>(filePath);
+}
+
+} // namespace domain::repositories
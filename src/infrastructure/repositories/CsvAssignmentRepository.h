@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../../domain/repositories/IAssignmentRepository.h"
+#include <expected>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// CSV Assignment Repository implementation
+class CsvAssignmentRepository : public domain::repositories::IAssignmentRepository {
+private:
+    std::string filePath_;
+    std::ofstream file_;
+    // CSV-escaped activity names và categories (cho header), lấy một lần trong open():
+    // catalog không được đọc sau open()
+    std::vector<std::string> fields_;
+    std::vector<domain::entities::ActivityCategory> categories_;
+    bool headerWritten_ = false;
+    std::string buffer_;
+public:
+    explicit CsvAssignmentRepository(std::string filePath);
+
+    [[nodiscard]] std::expected<void, std::string>
+    open(const domain::entities::ActivityIndex& catalog) override;
+
+    [[nodiscard]] std::expected<void, std::string>
+    saveAssignments(domain::repositories::AssignmentBatch batch) override;
+
+    [[nodiscard]] std::expected<void, std::string> close() override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createCsvAssignmentRepository(
+    const std::string& filePath);
+
+} // namespace domain::repositories
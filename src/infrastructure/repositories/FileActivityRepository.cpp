@@ -1,11 +1,19 @@
 #include "FileActivityRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "ActivityParsing.h"
+#include "../utils/MappedFile.h"
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string_view>
 
 namespace infrastructure::repositories {
 
-FileActivityRepository::FileActivityRepository(std::string filePath)
+FileActivityRepository::FileActivityRepository(std::string filePath, std::size_t parseThreads)
     : filePath_(std::move(filePath))
+    , parseThreads_(parseThreads)
 {
 }
 
@@ -16,50 +24,31 @@ FileActivityRepository::loadActivities() const
         return std::unexpected("File not found: " + filePath_);
     }
 
-    std::ifstream file(filePath_);
-    if (!file.is_open()) {
-        return std::unexpected("Permission denied: " + filePath_);
-    }
-
-    std::vector<domain::entities::Activity> activities;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        // Trim whitespace
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-        if (line.empty())
-            continue;
-
-        // Parse line: "ActivityName,Category"
-        auto commaPos = line.find(',');
-        if (commaPos == std::string::npos) {
-            return std::unexpected("Invalid format in line: " + line);
+    // Regular files được mmap; FIFO / process substitution không mmap được nên được
+    // đọc hết vào buffer
+    std::optional<utils::MappedFile> file;
+    std::string buffer;
+    std::string_view contents;
+    if (std::filesystem::is_regular_file(filePath_)) {
+        file = utils::MappedFile::open(filePath_);
+        if (!file) {
+            return std::unexpected("Permission denied: " + filePath_);
         }
-
-        std::string name = line.substr(0, commaPos);
-        std::string categoryStr = line.substr(commaPos + 1);
-
-        // Trim name and category
-        name.erase(0, name.find_first_not_of(" \t"));
-        name.erase(name.find_last_not_of(" \t") + 1);
-        categoryStr.erase(0, categoryStr.find_first_not_of(" \t"));
-        categoryStr.erase(categoryStr.find_last_not_of(" \t") + 1);
-
-        auto category = domain::entities::Activity::stringToCategory(categoryStr);
-        if (!category) {
-            return std::unexpected("Invalid category: " + categoryStr);
+        contents = file->contents();
+    } else {
+        std::ifstream stream(filePath_, std::ios::binary);
+        if (!stream.is_open()) {
+            return std::unexpected("Permission denied: " + filePath_);
         }
-
-        activities.emplace_back(std::move(name), *category);
-    }
-
-    if (file.bad()) {
-        return std::unexpected("Read error: " + filePath_);
+        buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        if (stream.bad()) {
+            return std::unexpected("Read error: " + filePath_);
+        }
+        contents = buffer;
     }
+    application::services::recordBytesRead(contents.size());
 
-    return activities;
+    return parseActivities(contents, parseThreads_);
 }
 
 std::expected<void, std::string>
@@ -72,7 +61,11 @@ FileActivityRepository::saveActivities(const std::vector<domain::entities::Activ
 
     for (const auto& activity : activities) {
         file << activity.getName() << ","
-             << activity.categoryToString(activity.getCategory()) << "\n";
+             << activity.categoryToString(activity.getCategory());
+        if (activity.hasCapacityLimit()) {
+            file << "," << activity.getCapacity();
+        }
+        file << "\n";
     }
 
     if (file.bad()) {
@@ -98,9 +91,9 @@ std::string FileActivityRepository::getRepositoryInfo() const noexcept
 namespace domain::repositories {
 
 std::unique_ptr<IActivityRepository> createFileActivityRepository(
-    const std::string& filePath)
+    const std::string& filePath, std::size_t parseThreads)
 {
-    return std::make_unique<infrastructure::repositories::FileActivityRepository>(filePath);
+    return std::make_unique<infrastructure::repositories::FileActivityRepository>(filePath, parseThreads);
 }
 
 } // namespace domain::repositories
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../domain/repositories/IActivityRepository.h"
+#include <cstddef>
 #include <expected>
 #include <string>
 
@@ -10,9 +11,11 @@ namespace infrastructure::repositories {
 class FileActivityRepository : public domain::repositories::IActivityRepository {
 private:
     std::string filePath_;
+    std::size_t parseThreads_;
 
 public:
-    explicit FileActivityRepository(std::string filePath);
+    // parseThreads: số workers tối đa cho parsing (0 hoặc 1 = tuần tự trên calling thread)
+    explicit FileActivityRepository(std::string filePath, std::size_t parseThreads = 0);
 
     // Load activities từ file
     [[nodiscard]] std::expected<std::vector<domain::entities::Activity>, std::string>
@@ -33,6 +36,6 @@ public:
 namespace domain::repositories {
 
 [[nodiscard]] std::unique_ptr<IActivityRepository> createFileActivityRepository(
-    const std::string& filePath);
+    const std::string& filePath, std::size_t parseThreads);
 
 } // namespace domain::repositories
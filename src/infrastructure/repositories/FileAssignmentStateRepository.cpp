@@ -0,0 +1,261 @@
+#include "FileAssignmentStateRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "../utils/MappedFile.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+namespace {
+
+// File layout (little-endian):
+//   "SAST", u32 version, u64 drawCount,
+//   u32 categoryCount, categoryCount x { u32 nameLength, name bytes },
+//   u32 activityCount, activityCount x { u32 category, u32 capacity, u32 nameLength, name bytes },
+//   u32 categoriesPerStudent, u32 studentCount,
+//   studentCount x { u32 packedStudentId, categoriesPerStudent x u32 activityId }
+// Category của activity là index vào category names của file, vì category ids
+// được intern theo thứ tự load nên không stable giữa các processes
+constexpr std::string_view MAGIC = "SAST";
+constexpr std::uint32_t FORMAT_VERSION = 2;
+
+void appendU32(std::string& out, std::uint32_t value)
+{
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>((value >> 8) & 0xFF);
+    out += static_cast<char>((value >> 16) & 0xFF);
+    out += static_cast<char>((value >> 24) & 0xFF);
+}
+
+// Bounds-checked sequential reader trên mapped contents
+class StateReader {
+private:
+    std::string_view data_;
+
+public:
+    explicit StateReader(std::string_view data) : data_(data) {}
+
+    [[nodiscard]] std::optional<std::string_view> bytes(std::size_t count) noexcept
+    {
+        if (data_.size() < count) {
+            return std::nullopt;
+        }
+        auto result = data_.substr(0, count);
+        data_.remove_prefix(count);
+        return result;
+    }
+
+    [[nodiscard]] std::optional<std::uint32_t> u32() noexcept
+    {
+        auto raw = bytes(4);
+        if (!raw) {
+            return std::nullopt;
+        }
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < 4; ++i) {
+            value |= std::uint32_t { static_cast<unsigned char>((*raw)[i]) } << (8 * i);
+        }
+        return value;
+    }
+
+    [[nodiscard]] std::size_t remaining() const noexcept { return data_.size(); }
+};
+
+} // namespace
+
+FileAssignmentStateRepository::FileAssignmentStateRepository(std::string filePath)
+    : filePath_(std::move(filePath))
+{
+}
+
+std::expected<domain::repositories::AssignmentState, std::string>
+FileAssignmentStateRepository::loadState() const
+{
+    // Chưa có state: lần chạy đầu tiên assign cả roster
+    if (!std::filesystem::exists(filePath_)) {
+        return domain::repositories::AssignmentState {};
+    }
+
+    auto file = utils::MappedFile::open(filePath_);
+    if (!file) {
+        return std::unexpected("Cannot open state file: " + filePath_);
+    }
+
+    application::services::recordBytesRead(file->size());
+
+    const std::string corrupt = "Corrupt state file: " + filePath_;
+    StateReader reader { file->contents() };
+
+    if (reader.bytes(MAGIC.size()) != MAGIC) {
+        return std::unexpected(corrupt);
+    }
+    const auto version = reader.u32();
+    if (version != FORMAT_VERSION) {
+        return std::unexpected(corrupt);
+    }
+
+    domain::repositories::AssignmentState state;
+    auto drawLo = reader.u32();
+    auto drawHi = reader.u32();
+    if (!drawLo || !drawHi) {
+        return std::unexpected(corrupt);
+    }
+    state.drawCount = (std::uint64_t { *drawHi } << 32) | *drawLo;
+
+    // Category table của file → category ids của process hiện tại
+    auto categoryCount = reader.u32();
+    if (!categoryCount) {
+        return std::unexpected(corrupt);
+    }
+    std::vector<domain::entities::ActivityCategory> categories;
+    for (std::uint32_t i = 0; i < *categoryCount; ++i) {
+        auto nameLength = reader.u32();
+        auto name = nameLength ? reader.bytes(*nameLength) : std::nullopt;
+        auto category = name ? domain::entities::Activity::internCategory(*name) : std::nullopt;
+        if (!category) {
+            return std::unexpected(corrupt);
+        }
+        categories.push_back(*category);
+    }
+
+    auto activityCount = reader.u32();
+    if (!activityCount) {
+        return std::unexpected(corrupt);
+    }
+    state.activities.reserve(*activityCount);
+    auto arena = std::make_shared<domain::entities::ActivityNameArena>();
+    for (std::uint32_t i = 0; i < *activityCount; ++i) {
+        auto category = reader.u32();
+        auto capacity = reader.u32();
+        auto nameLength = reader.u32();
+        if (!category || !capacity || !nameLength) {
+            return std::unexpected(corrupt);
+        }
+        auto name = reader.bytes(*nameLength);
+        if (!name || *category >= categories.size()) {
+            return std::unexpected(corrupt);
+        }
+        state.activities.emplace_back(arena, *name, categories[*category], *capacity);
+    }
+
+    auto stride = reader.u32();
+    auto studentCount = reader.u32();
+    if (!stride || !studentCount
+        || reader.remaining() != std::size_t { *studentCount } * (1 + *stride) * 4) {
+        return std::unexpected(corrupt);
+    }
+
+    state.categoriesPerStudent = *stride;
+    state.studentIds.reserve(*studentCount);
+    state.activityIds.reserve(std::size_t { *studentCount } * *stride);
+    for (std::uint32_t k = 0; k < *studentCount; ++k) {
+        const auto id = *reader.u32();
+        if (!state.studentIds.empty() && id <= state.studentIds.back()) {
+            return std::unexpected(corrupt);
+        }
+        state.studentIds.push_back(id);
+
+        for (std::uint32_t c = 0; c < *stride; ++c) {
+            const auto activityId = *reader.u32();
+            if (activityId >= *activityCount) {
+                return std::unexpected(corrupt);
+            }
+            state.activityIds.push_back(activityId);
+        }
+    }
+
+    return state;
+}
+
+std::expected<void, std::string>
+FileAssignmentStateRepository::saveState(const domain::repositories::AssignmentState& state)
+{
+    std::string buffer { MAGIC };
+    buffer.reserve(64 + state.studentIds.size() * 4 + state.activityIds.size() * 4);
+
+    appendU32(buffer, FORMAT_VERSION);
+    appendU32(buffer, static_cast<std::uint32_t>(state.drawCount));
+    appendU32(buffer, static_cast<std::uint32_t>(state.drawCount >> 32));
+
+    // Category table theo thứ tự xuất hiện đầu tiên trong catalog
+    std::vector<domain::entities::ActivityCategory> categories;
+    std::vector<std::uint32_t> fileCategoryOf;
+    for (const auto& activity : state.activities) {
+        const auto id = static_cast<std::size_t>(activity.getCategory());
+        if (id >= fileCategoryOf.size()) {
+            fileCategoryOf.resize(id + 1, UINT32_MAX);
+        }
+        if (fileCategoryOf[id] == UINT32_MAX) {
+            fileCategoryOf[id] = static_cast<std::uint32_t>(categories.size());
+            categories.push_back(activity.getCategory());
+        }
+    }
+    appendU32(buffer, static_cast<std::uint32_t>(categories.size()));
+    for (auto category : categories) {
+        const auto name = domain::entities::Activity::categoryToString(category);
+        appendU32(buffer, static_cast<std::uint32_t>(name.size()));
+        buffer += name;
+    }
+
+    appendU32(buffer, static_cast<std::uint32_t>(state.activities.size()));
+    for (const auto& activity : state.activities) {
+        appendU32(buffer, fileCategoryOf[static_cast<std::size_t>(activity.getCategory())]);
+        appendU32(buffer, activity.getCapacity());
+        appendU32(buffer, static_cast<std::uint32_t>(activity.getName().size()));
+        buffer += activity.getName();
+    }
+
+    const std::size_t stride = state.categoriesPerStudent;
+    appendU32(buffer, static_cast<std::uint32_t>(stride));
+    appendU32(buffer, static_cast<std::uint32_t>(state.studentIds.size()));
+    for (std::size_t k = 0; k < state.studentIds.size(); ++k) {
+        appendU32(buffer, state.studentIds[k]);
+        for (std::size_t c = 0; c < stride; ++c) {
+            appendU32(buffer, state.activityIds[k * stride + c]);
+        }
+    }
+
+    // Ghi vào temp file rồi rename, để crash giữa chừng không làm hỏng state cũ
+    const std::string tempPath = filePath_ + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return std::unexpected("Permission denied: " + tempPath);
+        }
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (!file.flush()) {
+            return std::unexpected("Write error: " + tempPath);
+        }
+        application::services::recordBytesWritten(buffer.size());
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath_, error);
+    if (error) {
+        return std::unexpected("Cannot replace state file " + filePath_ + ": " + error.message());
+    }
+    return {};
+}
+
+std::string FileAssignmentStateRepository::getRepositoryInfo() const noexcept
+{
+    return "FileAssignmentStateRepository: " + filePath_;
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IAssignmentStateRepository> createFileAssignmentStateRepository(
+    const std::string& filePath)
+{
+    return std::make_unique<infrastructure::repositories::FileAssignmentStateRepository>(filePath);
+}
+
+} // namespace domain::repositories
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../../domain/repositories/IAssignmentStateRepository.h"
+#include <expected>
+#include <string>
+
+namespace infrastructure::repositories {
+
+// Binary file-based Assignment State Repository implementation
+class FileAssignmentStateRepository : public domain::repositories::IAssignmentStateRepository {
+private:
+    std::string filePath_;
+
+public:
+    explicit FileAssignmentStateRepository(std::string filePath);
+
+    [[nodiscard]] std::expected<domain::repositories::AssignmentState, std::string>
+    loadState() const override;
+
+    [[nodiscard]] std::expected<void, std::string>
+    saveState(const domain::repositories::AssignmentState& state) override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IAssignmentStateRepository> createFileAssignmentStateRepository(
+    const std::string& filePath);
+
+} // namespace domain::repositories
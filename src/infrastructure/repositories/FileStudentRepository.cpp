@@ -1,8 +1,10 @@
 #include "FileStudentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "../utils/DigitParsing.h"
+#include <array>
 #include <filesystem>
 #include <fstream>
-#include <algorithm>
-#include <cctype>
+#include <utility>
 
 namespace infrastructure::repositories {
 
@@ -11,8 +13,8 @@ FileStudentRepository::FileStudentRepository(std::string filePath)
 {
 }
 
-std::optional<std::vector<domain::entities::Student>>
-FileStudentRepository::loadStudents() const
+std::optional<domain::repositories::IStudentRepository::StudentList>
+FileStudentRepository::loadStudents(std::pmr::memory_resource* resource) const
 {
     if (!std::filesystem::exists(filePath_)) {
         return std::nullopt;
@@ -23,10 +25,19 @@ FileStudentRepository::loadStudents() const
         return std::nullopt;
     }
 
-    std::vector<domain::entities::Student> students;
+    // Reserve theo file size (một ID + newline mỗi dòng): tránh regrowth copies,
+    // quan trọng với monotonic arena vì buffers cũ không được reuse
+    StudentList students(resource);
+    std::error_code sizeError;
+    if (const auto fileSize = std::filesystem::file_size(filePath_, sizeError); !sizeError) {
+        students.reserve(static_cast<std::size_t>(fileSize) / (domain::entities::Student::ID_LENGTH + 1) + 1);
+    }
     std::string line;
+    std::uint64_t bytesRead = 0;
 
     while (std::getline(file, line)) {
+        bytesRead += line.size() + 1;
+
         // Trim whitespace
         line.erase(0, line.find_first_not_of(" \t\r\n"));
         line.erase(line.find_last_not_of(" \t\r\n") + 1);
@@ -34,12 +45,13 @@ FileStudentRepository::loadStudents() const
         if (line.empty())
             continue;
 
-        // Simple validation: just check if line is not empty
-        if (line.length() == 8 && std::all_of(line.begin(), line.end(), ::isdigit)) {
-            students.emplace_back(line);
+        // Validate 8-digit ID và pack thành integer
+        if (line.length() == domain::entities::Student::ID_LENGTH && utils::isEightDigits(line.data())) {
+            students.emplace_back(utils::parseEightDigits(line.data()));
         }
     }
 
+    application::services::recordBytesRead(bytesRead);
     if (file.bad()) {
         return std::nullopt;
     }
@@ -47,6 +59,48 @@ FileStudentRepository::loadStudents() const
     return students;
 }
 
+bool
+FileStudentRepository::streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+    std::pmr::memory_resource* resource) const
+{
+    std::ifstream file(filePath_);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    StudentList chunk(resource);
+    chunk.reserve(chunkSize);
+    std::string line;
+    std::uint64_t bytesRead = 0;
+
+    while (std::getline(file, line)) {
+        bytesRead += line.size() + 1;
+
+        // Trim whitespace
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+
+        if (line.length() == domain::entities::Student::ID_LENGTH && utils::isEightDigits(line.data())) {
+            chunk.emplace_back(utils::parseEightDigits(line.data()));
+        }
+
+        if (chunk.size() == chunkSize) {
+            application::services::recordBytesRead(std::exchange(bytesRead, 0));
+            if (!consumer(chunk)) {
+                return false;
+            }
+            chunk.clear();
+        }
+    }
+
+    application::services::recordBytesRead(bytesRead);
+    if (file.bad()) {
+        return false;
+    }
+
+    return chunk.empty() || consumer(chunk);
+}
+
 bool
 FileStudentRepository::saveStudents(const std::vector<domain::entities::Student>& students) const
 {
@@ -55,8 +109,12 @@ FileStudentRepository::saveStudents(const std::vector<domain::entities::Student>
         return false;
     }
 
+    // Format packed IDs vào stack buffer, không allocate per student
+    std::array<char, domain::entities::Student::ID_LENGTH + 1> line {};
+    line.back() = '\n';
     for (const auto& student : students) {
-        file << student.getId() << '\n';
+        student.writeId(std::span(line).first<domain::entities::Student::ID_LENGTH>());
+        file.write(line.data(), static_cast<std::streamsize>(line.size()));
     }
 
     return !file.bad();
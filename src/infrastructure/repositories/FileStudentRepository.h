@@ -15,8 +15,13 @@ public:
     explicit FileStudentRepository(std::string filePath);
 
     // Load students từ file
-    [[nodiscard]] std::optional<std::vector<domain::entities::Student>>
-    loadStudents() const override;
+    [[nodiscard]] std::optional<StudentList>
+    loadStudents(std::pmr::memory_resource* resource) const override;
+
+    // Stream students theo chunks
+    [[nodiscard]] bool
+    streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+        std::pmr::memory_resource* resource) const override;
 
     // Save students to file
     [[nodiscard]] bool
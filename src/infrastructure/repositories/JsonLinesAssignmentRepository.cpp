@@ -0,0 +1,125 @@
+#include "JsonLinesAssignmentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include <array>
+#include <string_view>
+
+namespace infrastructure::repositories {
+
+namespace {
+
+// JSON string literal với escaping theo RFC 8259
+[[nodiscard]] std::string quoteJson(std::string_view value)
+{
+    constexpr std::string_view hex = "0123456789abcdef";
+
+    std::string quoted = "\"";
+    for (char c : value) {
+        switch (c) {
+        case '"': quoted += "\\\""; break;
+        case '\\': quoted += "\\\\"; break;
+        case '\n': quoted += "\\n"; break;
+        case '\r': quoted += "\\r"; break;
+        case '\t': quoted += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                quoted += "\\u00";
+                quoted += hex[static_cast<unsigned char>(c) >> 4];
+                quoted += hex[static_cast<unsigned char>(c) & 0xF];
+            } else {
+                quoted += c;
+            }
+        }
+    }
+    quoted += '"';
+    return quoted;
+}
+
+} // namespace
+
+JsonLinesAssignmentRepository::JsonLinesAssignmentRepository(std::string filePath)
+    : filePath_(std::move(filePath))
+{
+}
+
+std::expected<void, std::string>
+JsonLinesAssignmentRepository::open(const domain::entities::ActivityIndex& catalog)
+{
+    file_.open(filePath_, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return std::unexpected("Permission denied: " + filePath_);
+    }
+
+    objects_.clear();
+    objects_.reserve(catalog.size());
+    for (const auto& activity : catalog.getActivities()) {
+        objects_.push_back("{\"name\":" + quoteJson(activity.getName())
+            + ",\"category\":" + quoteJson(domain::entities::Activity::categoryToString(activity.getCategory()))
+            + "}");
+    }
+    return {};
+}
+
+std::expected<void, std::string>
+JsonLinesAssignmentRepository::saveAssignments(domain::repositories::AssignmentBatch batch)
+{
+    if (!file_.is_open()) {
+        return std::unexpected("Repository not open: " + filePath_);
+    }
+
+    buffer_.clear();
+    const std::size_t stride = batch.categoriesPerStudent;
+
+    // {"student_id":"24127000","activities":[{"name":...,"category":...},...]}
+    std::array<char, domain::entities::Student::ID_LENGTH> id {};
+    for (std::size_t k = 0; k < batch.students.size(); ++k) {
+        batch.students[k].writeId(id);
+        buffer_ += "{\"student_id\":\"";
+        buffer_.append(id.data(), id.size());
+        buffer_ += "\",\"activities\":[";
+        for (std::size_t c = 0; c < stride; ++c) {
+            if (c > 0) {
+                buffer_ += ',';
+            }
+            buffer_ += objects_[batch.activityIds[k * stride + c]];
+        }
+        buffer_ += "]}\n";
+    }
+
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    application::services::recordBytesWritten(buffer_.size());
+    if (file_.bad()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::expected<void, std::string> JsonLinesAssignmentRepository::close()
+{
+    if (!file_.is_open()) {
+        return {};
+    }
+
+    file_.close();
+    if (file_.fail()) {
+        return std::unexpected("Write error: " + filePath_);
+    }
+    return {};
+}
+
+std::string JsonLinesAssignmentRepository::getRepositoryInfo() const noexcept
+{
+    return "JsonLinesAssignmentRepository: " + filePath_;
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IAssignmentRepository> createJsonLinesAssignmentRepository(
+    const std::string& filePath)
+{
+    return std::make_unique<infrastructure::repositories::JsonLinesAssignmentRepository>(filePath);
+}
+
+} // namespace domain::repositories
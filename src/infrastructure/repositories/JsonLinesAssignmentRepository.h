@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../domain/repositories/IAssignmentRepository.h"
+#include <expected>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace infrastructure::repositories {
+
+// JSON Lines Assignment Repository implementation
+class JsonLinesAssignmentRepository : public domain::repositories::IAssignmentRepository {
+private:
+    std::string filePath_;
+    std::ofstream file_;
+
+    // JSON object của mỗi activity, render một lần trong open()
+    std::vector<std::string> objects_;
+    std::string buffer_;
+public:
+    explicit JsonLinesAssignmentRepository(std::string filePath);
+
+    [[nodiscard]] std::expected<void, std::string>
+    open(const domain::entities::ActivityIndex& catalog) override;
+
+    [[nodiscard]] std::expected<void, std::string>
+    saveAssignments(domain::repositories::AssignmentBatch batch) override;
+
+    [[nodiscard]] std::expected<void, std::string> close() override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IAssignmentRepository> createJsonLinesAssignmentRepository(
+    const std::string& filePath);
+
+} // namespace domain::repositories
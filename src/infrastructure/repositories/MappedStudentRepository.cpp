@@ -0,0 +1,101 @@
+#include "MappedStudentRepository.h"
+#include "../../application/services/RunStatistics.h"
+#include "FileStudentRepository.h"
+#include "StudentParsing.h"
+#include "../utils/MappedFile.h"
+#include <filesystem>
+
+namespace infrastructure::repositories {
+
+MappedStudentRepository::MappedStudentRepository(std::string filePath, std::size_t parseThreads)
+    : filePath_(std::move(filePath))
+    , parseThreads_(parseThreads)
+{
+}
+
+std::optional<domain::repositories::IStudentRepository::StudentList>
+MappedStudentRepository::loadStudents(std::pmr::memory_resource* resource) const
+{
+    // FIFO / process substitution không mmap được: đọc như stream-based repository
+    if (!std::filesystem::is_regular_file(filePath_)) {
+        return FileStudentRepository(filePath_).loadStudents(resource);
+    }
+
+    auto file = utils::MappedFile::open(filePath_);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    application::services::recordBytesRead(file->size());
+
+    StudentList students(resource);
+    // Ước lượng một ID (8 digits + newline) mỗi dòng
+    students.reserve(file->size() / (domain::entities::Student::ID_LENGTH + 1) + 1);
+
+    appendStudents(file->contents(), parseThreads_, students);
+    return students;
+}
+
+bool
+MappedStudentRepository::streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+    std::pmr::memory_resource* resource) const
+{
+    if (!std::filesystem::is_regular_file(filePath_)) {
+        return FileStudentRepository(filePath_).streamStudents(chunkSize, consumer, resource);
+    }
+
+    auto file = utils::MappedFile::open(filePath_);
+    if (!file) {
+        return false;
+    }
+
+    application::services::recordBytesRead(file->size());
+
+    StudentList chunk(resource);
+    chunk.reserve(chunkSize);
+
+    StudentScanner scanner(file->contents());
+    while (auto student = scanner.next()) {
+        chunk.push_back(*student);
+        if (chunk.size() == chunkSize) {
+            if (!consumer(chunk)) {
+                return false;
+            }
+            chunk.clear();
+            // Pages đã scan không cần nữa
+            file->releaseUpTo(scanner.position());
+        }
+    }
+
+    return chunk.empty() || consumer(chunk);
+}
+
+bool
+MappedStudentRepository::saveStudents(const std::vector<domain::entities::Student>& students) const
+{
+    // Write path giống stream-based repository
+    return FileStudentRepository(filePath_).saveStudents(students);
+}
+
+bool MappedStudentRepository::isAvailable() const noexcept
+{
+    return std::filesystem::exists(filePath_) || std::filesystem::exists(std::filesystem::path(filePath_).parent_path());
+}
+
+std::string MappedStudentRepository::getRepositoryInfo() const noexcept
+{
+    return "MappedStudentRepository: " + filePath_;
+}
+
+} // namespace infrastructure::repositories
+
+// Factory implementation
+namespace domain::repositories {
+
+std::unique_ptr<IStudentRepository> createMappedStudentRepository(
+    const std::string& filePath, std::size_t parseThreads)
+{
+    return std::make_unique<infrastructure::repositories::MappedStudentRepository>(filePath, parseThreads);
+}
+
+} // namespace domain::repositories
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../../domain/repositories/IStudentRepository.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace infrastructure::repositories {
+
+// Memory-mapped Student Repository: scan mapped buffer trực tiếp, validate IDs in place.
+// FileStudentRepository vẫn là stream-based fallback để so sánh
+class MappedStudentRepository : public domain::repositories::IStudentRepository {
+private:
+    std::string filePath_;
+    std::size_t parseThreads_;
+
+public:
+    // parseThreads: số workers tối đa cho parsing (0 hoặc 1 = tuần tự trên calling thread)
+    explicit MappedStudentRepository(std::string filePath, std::size_t parseThreads = 0);
+
+    // Load students từ mapped file
+    [[nodiscard]] std::optional<StudentList>
+    loadStudents(std::pmr::memory_resource* resource) const override;
+
+    // Stream students theo chunks
+    [[nodiscard]] bool
+    streamStudents(std::size_t chunkSize, const StudentChunkConsumer& consumer,
+        std::pmr::memory_resource* resource) const override;
+
+    // Save students to file
+    [[nodiscard]] bool
+    saveStudents(const std::vector<domain::entities::Student>& students) const override;
+
+    [[nodiscard]] bool isAvailable() const noexcept override;
+
+    [[nodiscard]] std::string getRepositoryInfo() const noexcept override;
+};
+
+} // namespace infrastructure::repositories
+
+// Factory function declaration
+namespace domain::repositories {
+
+[[nodiscard]] std::unique_ptr<IStudentRepository> createMappedStudentRepository(
+    const std::string& filePath, std::size_t parseThreads);
+
+} // namespace domain::repositories
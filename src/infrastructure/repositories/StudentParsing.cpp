@@ -0,0 +1,31 @@
+#include "StudentParsing.h"
+#include "../utils/LineChunks.h"
+#include <vector>
+
+namespace infrastructure::repositories {
+
+void appendStudents(std::string_view text, std::size_t parseThreads,
+    domain::repositories::IStudentRepository::StudentList& out)
+{
+    const auto chunks = utils::splitAtNewlines(text, parseThreads);
+
+    // Chunk đầu được parse thẳng vào out trên calling thread; các chunks khác vào buffers
+    // riêng của workers (resource của out có thể là arena không thread-safe)
+    std::vector<std::vector<domain::entities::Student>> parsed(chunks.size() - 1);
+    utils::runChunks(chunks.size(), [&](std::size_t i) {
+        if (i == 0) {
+            scanStudents(chunks[0], out);
+            return;
+        }
+        auto& students = parsed[i - 1];
+        // Ước lượng một ID (8 digits + newline) mỗi dòng
+        students.reserve(chunks[i].size() / (domain::entities::Student::ID_LENGTH + 1) + 1);
+        scanStudents(chunks[i], students);
+    });
+
+    for (const auto& students : parsed) {
+        out.insert(out.end(), students.begin(), students.end());
+    }
+}
+
+} // namespace infrastructure::repositories
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../../domain/entities/Student.h"
+#include "../../domain/repositories/IStudentRepository.h"
+#include "../utils/DigitParsing.h"
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+namespace infrastructure::repositories {
+
+// Sequential scanner trên text buffer (mapped file hoặc block đã đọc): trả về từng
+// valid student, không allocate. Dòng được trim, dòng không phải 8-digit ID bị bỏ qua
+class StudentScanner {
+private:
+    const char* cursor_;
+    const char* const begin_;
+    const char* const end_;
+
+    [[nodiscard]] static constexpr bool isTrimmed(char c) noexcept
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+public:
+    explicit StudentScanner(std::string_view contents) noexcept
+        : cursor_(contents.data())
+        , begin_(contents.data())
+        , end_(contents.data() + contents.size())
+    {
+    }
+
+    // Byte offset của dòng tiếp theo
+    [[nodiscard]] std::size_t position() const noexcept
+    {
+        return static_cast<std::size_t>(cursor_ - begin_);
+    }
+
+    [[nodiscard]] std::optional<domain::entities::Student> next() noexcept
+    {
+        while (cursor_ < end_) {
+            // memchr là vectorized newline search trong libc
+            const auto* newline = static_cast<const char*>(
+                std::memchr(cursor_, '\n', static_cast<std::size_t>(end_ - cursor_)));
+            const char* lineEnd = newline != nullptr ? newline : end_;
+
+            // Trim whitespace in place
+            const char* first = cursor_;
+            const char* last = lineEnd;
+            while (first < last && isTrimmed(*first)) {
+                ++first;
+            }
+            while (last > first && isTrimmed(*(last - 1))) {
+                --last;
+            }
+
+            cursor_ = newline != nullptr ? newline + 1 : end_;
+
+            // Validate và pack ID trực tiếp từ buffer
+            if (static_cast<std::size_t>(last - first) == domain::entities::Student::ID_LENGTH
+                && utils::isEightDigits(first)) {
+                return domain::entities::Student { utils::parseEightDigits(first) };
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+// Append mọi valid student trong text vào out theo thứ tự
+template <typename Container>
+void scanStudents(std::string_view text, Container& out)
+{
+    StudentScanner scanner(text);
+    while (auto student = scanner.next()) {
+        out.push_back(*student);
+    }
+}
+
+// Parse text theo chunks tại newline boundaries trên tối đa parseThreads workers
+// (0 hoặc 1 = tuần tự), append students vào out theo thứ tự trong text.
+// Chỉ calling thread allocate từ resource của out
+void appendStudents(std::string_view text, std::size_t parseThreads,
+    domain::repositories::IStudentRepository::StudentList& out);
+
+} // namespace infrastructure::repositories
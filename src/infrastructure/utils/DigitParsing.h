@@ -0,0 +1,39 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace infrastructure::utils {
+
+// SWAR check: 8 bytes tại `chars` đều là ASCII digits '0'..'9'
+[[nodiscard]] inline bool isEightDigits(const char* chars) noexcept
+{
+    std::uint64_t word;
+    std::memcpy(&word, chars, sizeof(word));
+
+    // High nibble phải là 0x3, và cộng 6 vào low nibble không được tràn ('9' + 6 = 0x3F)
+    return (word & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL
+        && ((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL;
+}
+
+// SWAR (SIMD within a register) conversion 8 ASCII digits -> integer.
+// Precondition: isEightDigits(chars)
+[[nodiscard]] inline std::uint32_t parseEightDigits(const char* chars) noexcept
+{
+    std::uint64_t word;
+    std::memcpy(&word, chars, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = ((word & 0x00000000FFFFFFFFULL) << 32) | ((word & 0xFFFFFFFF00000000ULL) >> 32);
+        word = ((word & 0x0000FFFF0000FFFFULL) << 16) | ((word & 0xFFFF0000FFFF0000ULL) >> 16);
+        word = ((word & 0x00FF00FF00FF00FFULL) << 8) | ((word & 0xFF00FF00FF00FF00ULL) >> 8);
+    }
+
+    // Ghép digits theo cặp: 1-digit -> 2-digit -> 4-digit -> 8-digit lanes
+    word = ((word & 0x0F0F0F0F0F0F0F0FULL) * ((10ULL << 8) + 1)) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFULL) * ((100ULL << 16) + 1)) >> 16;
+    word = ((word & 0x0000FFFF0000FFFFULL) * ((10000ULL << 32) + 1)) >> 32;
+    return static_cast<std::uint32_t>(word);
+}
+
+} // namespace infrastructure::utils
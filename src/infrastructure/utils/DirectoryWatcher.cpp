@@ -0,0 +1,101 @@
+#include "DirectoryWatcher.h"
+#include <utility>
+
+#if defined(__linux__)
+#include <cstdint>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace infrastructure::utils {
+
+#if defined(__linux__)
+
+std::optional<DirectoryWatcher> DirectoryWatcher::open(const std::string& directory)
+{
+    const int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    // IN_CLOSE_WRITE cho in-place writes, IN_MOVED_TO cho editors save bằng rename.
+    // Không watch IN_CREATE/IN_MODIFY để không đọc file đang ghi dở
+    constexpr std::uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE;
+    if (::inotify_add_watch(fd, directory.c_str(), mask) < 0) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    DirectoryWatcher watcher;
+    watcher.fd_ = fd;
+    return watcher;
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+DirectoryWatcher::DirectoryWatcher(DirectoryWatcher&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1))
+{
+}
+
+DirectoryWatcher& DirectoryWatcher::operator=(DirectoryWatcher&& other) noexcept
+{
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+}
+
+std::vector<std::string> DirectoryWatcher::readChanges()
+{
+    std::vector<std::string> changes;
+    alignas(inotify_event) char buffer[4096];
+
+    for (;;) {
+        const ssize_t length = ::read(fd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN: không còn events
+        }
+
+        for (ssize_t offset = 0; offset < length;) {
+            inotify_event event;
+            std::memcpy(&event, buffer + offset, sizeof(event));
+            if (event.len > 0) {
+                changes.emplace_back(buffer + offset + sizeof(inotify_event));
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+        }
+    }
+    return changes;
+}
+
+#else
+
+std::optional<DirectoryWatcher> DirectoryWatcher::open(const std::string& /*directory*/)
+{
+    return std::nullopt;
+}
+
+DirectoryWatcher::~DirectoryWatcher() = default;
+
+DirectoryWatcher::DirectoryWatcher(DirectoryWatcher&& other) noexcept = default;
+
+DirectoryWatcher& DirectoryWatcher::operator=(DirectoryWatcher&& other) noexcept = default;
+
+std::vector<std::string> DirectoryWatcher::readChanges()
+{
+    return {};
+}
+
+#endif
+
+} // namespace infrastructure::utils
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace infrastructure::utils {
+
+// RAII inotify watch trên một directory (Linux). Report tên các files được ghi xong,
+// rename vào hoặc xoá; trên platforms khác open() trả về std::nullopt
+class DirectoryWatcher {
+private:
+    int fd_ = -1;
+
+    DirectoryWatcher() = default;
+
+public:
+    [[nodiscard]] static std::optional<DirectoryWatcher> open(const std::string& directory);
+
+    ~DirectoryWatcher();
+    DirectoryWatcher(DirectoryWatcher&& other) noexcept;
+    DirectoryWatcher& operator=(DirectoryWatcher&& other) noexcept;
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    // Non-blocking descriptor để poll() cùng các inputs khác
+    [[nodiscard]] int fileDescriptor() const noexcept { return fd_; }
+
+    // Đọc hết events đang pending; tên files (không có directory), có thể lặp lại
+    [[nodiscard]] std::vector<std::string> readChanges();
+};
+
+} // namespace infrastructure::utils
@@ -0,0 +1,32 @@
+#include "FileFingerprint.h"
+#include <system_error>
+
+namespace infrastructure::utils {
+
+std::optional<FileStamp> statFile(const std::string& filePath)
+{
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(filePath, error);
+    if (error) {
+        return std::nullopt;
+    }
+    const auto size = std::filesystem::file_size(filePath, error);
+    if (error) {
+        return std::nullopt;
+    }
+    return FileStamp { .modified = modified, .size = size };
+}
+
+std::uint64_t hashContents(std::string_view contents) noexcept
+{
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325ull;
+    constexpr std::uint64_t FNV_PRIME = 0x100000001B3ull;
+
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    for (unsigned char byte : contents) {
+        hash = (hash ^ byte) * FNV_PRIME;
+    }
+    return hash;
+}
+
+} // namespace infrastructure::utils
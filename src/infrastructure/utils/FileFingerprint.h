@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace infrastructure::utils {
+
+// mtime + size của một file: so sánh rẻ (một stat) để biết file có thể đã đổi
+struct FileStamp {
+    std::filesystem::file_time_type modified;
+    std::uintmax_t size;
+
+    [[nodiscard]] bool operator==(const FileStamp&) const = default;
+};
+
+// Stamp + content hash; hash phân biệt file bị touch với file thật sự đổi nội dung
+struct FileFingerprint {
+    FileStamp stamp;
+    std::uint64_t contentHash;
+};
+
+// std::nullopt nếu file không tồn tại hoặc không stat được
+[[nodiscard]] std::optional<FileStamp> statFile(const std::string& filePath);
+
+// 64-bit FNV-1a của contents
+[[nodiscard]] std::uint64_t hashContents(std::string_view contents) noexcept;
+
+} // namespace infrastructure::utils
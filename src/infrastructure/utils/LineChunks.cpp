@@ -0,0 +1,32 @@
+#include "LineChunks.h"
+#include <algorithm>
+
+namespace infrastructure::utils {
+
+std::vector<std::string_view> splitAtNewlines(
+    std::string_view text, std::size_t maxChunks, std::size_t minChunkBytes)
+{
+    const std::size_t chunkCount = std::clamp<std::size_t>(
+        text.size() / std::max<std::size_t>(minChunkBytes, 1), 1, std::max<std::size_t>(maxChunks, 1));
+
+    std::vector<std::string_view> chunks;
+    chunks.reserve(chunkCount);
+
+    // Boundary thứ i: newline đầu tiên từ vị trí i / chunkCount của text
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i < chunkCount; ++i) {
+        const std::size_t target = std::max(begin, text.size() / chunkCount * i);
+        const auto newline = text.find('\n', target);
+        if (newline == std::string_view::npos) {
+            break;
+        }
+        chunks.push_back(text.substr(begin, newline + 1 - begin));
+        begin = newline + 1;
+    }
+    if (begin < text.size() || chunks.empty()) {
+        chunks.push_back(text.substr(begin));
+    }
+    return chunks;
+}
+
+} // namespace infrastructure::utils
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace infrastructure::utils {
+
+// Chunk nhỏ nhất được parse trên một worker riêng; text nhỏ hơn được parse tuần tự
+inline constexpr std::size_t MIN_PARSE_CHUNK_BYTES = std::size_t { 1 } << 20;
+
+// Chia text thành tối đa maxChunks chunks liên tiếp có kích thước gần bằng nhau (mỗi chunk
+// ít nhất minChunkBytes). Mọi chunk trừ chunk cuối kết thúc ngay sau một '\n', nên không
+// dòng nào bị cắt. Luôn trả về ít nhất một chunk
+[[nodiscard]] std::vector<std::string_view> splitAtNewlines(
+    std::string_view text, std::size_t maxChunks, std::size_t minChunkBytes = MIN_PARSE_CHUNK_BYTES);
+
+// Gọi task(i) với mọi i trong [0, count): i = 0 trên calling thread, mỗi i còn lại trên
+// một worker thread riêng; return khi tất cả đã xong. task không được throw trên workers
+template <typename Task>
+void runChunks(std::size_t count, const Task& task)
+{
+    std::vector<std::jthread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (std::size_t i = 1; i < count; ++i) {
+        workers.emplace_back([&task, i] { task(i); });
+    }
+    if (count > 0) {
+        task(0);
+    }
+}
+
+} // namespace infrastructure::utils
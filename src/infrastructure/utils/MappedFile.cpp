@@ -0,0 +1,129 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace infrastructure::utils {
+
+#if defined(__unix__) || defined(__APPLE__)
+
+std::optional<MappedFile> MappedFile::open(const std::string& filePath)
+{
+    const int fd = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+
+    MappedFile file;
+    file.size_ = static_cast<std::size_t>(info.st_size);
+
+    // mmap với length 0 là invalid; empty file map thành empty view
+    if (file.size_ > 0) {
+        void* address = ::mmap(nullptr, file.size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        ::madvise(address, file.size_, MADV_SEQUENTIAL);
+        file.data_ = static_cast<const char*>(address);
+    }
+
+    // Mapping vẫn valid sau khi close file descriptor
+    ::close(fd);
+    return file;
+}
+
+void MappedFile::releaseUpTo(std::size_t offset) noexcept
+{
+    const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t length = std::min(offset, size_) / pageSize * pageSize;
+    if (data_ != nullptr && length > 0) {
+        ::madvise(const_cast<char*>(data_), length, MADV_DONTNEED);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+#else
+
+std::optional<MappedFile> MappedFile::open(const std::string& filePath)
+{
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream.is_open()) {
+        return std::nullopt;
+    }
+
+    MappedFile file;
+    file.buffer_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    if (stream.bad()) {
+        return std::nullopt;
+    }
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+    return file;
+}
+
+void MappedFile::releaseUpTo(std::size_t /*offset*/) noexcept {}
+
+MappedFile::~MappedFile() = default;
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : buffer_(std::move(other.buffer_))
+{
+    data_ = buffer_.data();
+    size_ = std::exchange(other.size_, 0);
+    other.data_ = nullptr;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        buffer_ = std::move(other.buffer_);
+        data_ = buffer_.data();
+        size_ = std::exchange(other.size_, 0);
+        other.data_ = nullptr;
+    }
+    return *this;
+}
+
+#endif
+
+} // namespace infrastructure::utils
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace infrastructure::utils {
+
+// RAII read-only memory mapping của một file (mmap trên POSIX).
+// Trên platforms không có mmap, contents được đọc vào một buffer
+class MappedFile {
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+    std::string buffer_;
+#endif
+
+    MappedFile() = default;
+
+public:
+    // Map file; std::nullopt nếu không mở được
+    [[nodiscard]] static std::optional<MappedFile> open(const std::string& filePath);
+
+    ~MappedFile();
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Drop pages trong [0, offset) khỏi resident set sau khi đã xử lý xong,
+    // để sequential scan của file lớn giữ RSS ổn định
+    void releaseUpTo(std::size_t offset) noexcept;
+
+    [[nodiscard]] std::string_view contents() const noexcept { return { data_, size_ }; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
+
+} // namespace infrastructure::utils
@@ -1,69 +1,351 @@
 #include "application/services/ActivityAssignmentService.h"
 #include "application/strategies/IRandomSelectionStrategy.h"
+#include "domain/entities/Activity.h"
 #include "domain/repositories/IActivityRepository.h"
 #include "domain/repositories/IStudentRepository.h"
 #include "infrastructure/repositories/FileActivityRepository.h"
+#include "infrastructure/repositories/FileAssignmentStateRepository.h"
 #include "infrastructure/repositories/FileStudentRepository.h"
+#include "infrastructure/repositories/MappedStudentRepository.h"
+#include "infrastructure/repositories/AsyncAssignmentRepository.h"
+#include "infrastructure/repositories/BinaryAssignmentRepository.h"
+#include "infrastructure/repositories/CsvAssignmentRepository.h"
+#include "infrastructure/repositories/JsonLinesAssignmentRepository.h"
 #include "presentation/controllers/ActivityAssignmentController.h"
+#include "presentation/daemon/AssignmentDaemon.h"
+#include "presentation/server/QueryServer.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 // Nested namespace definitions (C++17)
 namespace app::config {
 constexpr std::string_view STUDENTS_FILE = "data/students.txt";
 constexpr std::string_view ACTIVITIES_FILE = "data/activities.txt";
+
+// Command-line options
+struct Options {
+    // 0 = sequential; >= 1 = parallel workers
+    std::size_t threadCount = 0;
+    // Seed cho strategies; không set thì lấy từ std::random_device
+    std::optional<std::uint64_t> seed;
+    // true = mmap roster loader; false = stream-based fallback
+    bool mappedRoster = true;
+    // 0 = batch mode; > 0 = streaming mode với chunk size này
+    std::size_t streamChunkSize = 0;
+    // Output file; không set thì in ra stdout
+    std::optional<std::string> outputPath;
+    std::string outputFormat = "csv";
+    // Enforce activity capacities từ activities.txt
+    bool capacityConstrained = false;
+    // standard | weighted | balanced
+    std::string strategy = "standard";
+    // Set thì chạy incremental mode với state file này
+    std::optional<std::string> statePath;
+    // Long-running mode: resident data, hot reload, commands từ stdin
+    bool daemon = false;
+    // Set thì serve lookups trên Unix socket này
+    std::optional<std::string> serveSocket;
+    // Set thì report per-phase timing và counters (--stats text|json)
+    std::optional<presentation::controllers::StatisticsFormat> statisticsFormat;
+    // true = run-scoped arena (--allocator arena); false = default allocator (--allocator heap)
+    bool runArena = true;
+    // Không rỗng thì catalog chỉ được dùng built-ins và các categories này (--categories A,B)
+    std::vector<std::string> categories;
+};
+
+// Default chunk size cho --stream
+constexpr std::size_t DEFAULT_STREAM_CHUNK_SIZE = 65536;
+
+// Số batches tối đa chờ trong queue của async output writer
+constexpr std::size_t OUTPUT_QUEUE_CAPACITY = 8;
+
+// Parse unsigned integer argument value
+template <typename T>
+[[nodiscard]] std::optional<T> parseNumber(std::string_view value)
+{
+    T number {};
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc {} || ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return number;
 }
 
+// Parse "--threads N" (N = 0 chọn hardware_concurrency), "--seed S", "--loader mmap|stream",
+// "--stream" và "--chunk-size N" (streaming mode), "--output PATH", "--format csv|jsonl|binary"
+// "--capacity" (capacity-aware mode), "--strategy standard|weighted|balanced"
+// "--state PATH" (incremental mode), "--daemon" và "--serve SOCKET" (query server),
+// "--stats text|json" (run statistics), "--allocator arena|heap" (per-run allocations),
+// "--categories A,B,..." (categories hợp lệ ngoài built-ins)
+[[nodiscard]] std::optional<Options> parseArguments(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            auto threadCount = parseNumber<std::size_t>(value);
+            if (!threadCount) {
+                std::cerr << "Invalid thread count: " << value << "\n";
+                return std::nullopt;
+            }
+            options.threadCount = *threadCount == 0
+                ? std::max(1u, std::thread::hardware_concurrency())
+                : *threadCount;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            options.seed = parseNumber<std::uint64_t>(value);
+            if (!options.seed) {
+                std::cerr << "Invalid seed: " << value << "\n";
+                return std::nullopt;
+            }
+        } else if (arg == "--loader" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (value != "mmap" && value != "stream") {
+                std::cerr << "Invalid loader: " << value << " (expected mmap or stream)\n";
+                return std::nullopt;
+            }
+            options.mappedRoster = value == "mmap";
+        } else if (arg == "--stream") {
+            options.streamChunkSize = DEFAULT_STREAM_CHUNK_SIZE;
+        } else if (arg == "--chunk-size" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            auto chunkSize = parseNumber<std::size_t>(value);
+            if (!chunkSize || *chunkSize == 0) {
+                std::cerr << "Invalid chunk size: " << value << "\n";
+                return std::nullopt;
+            }
+            options.streamChunkSize = *chunkSize;
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.outputPath = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (value != "csv" && value != "jsonl" && value != "binary") {
+                std::cerr << "Invalid format: " << value << " (expected csv, jsonl or binary)\n";
+                return std::nullopt;
+            }
+            options.outputFormat = value;
+        } else if (arg == "--capacity") {
+            options.capacityConstrained = true;
+        } else if (arg == "--strategy" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (value != "standard" && value != "weighted" && value != "balanced") {
+                std::cerr << "Invalid strategy: " << value << " (expected standard, weighted or balanced)\n";
+                return std::nullopt;
+            }
+            options.strategy = value;
+        } else if (arg == "--state" && i + 1 < argc) {
+            options.statePath = argv[++i];
+        } else if (arg == "--daemon") {
+            options.daemon = true;
+        } else if (arg == "--serve" && i + 1 < argc) {
+            options.serveSocket = argv[++i];
+        } else if (arg == "--stats" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (!application::services::STATS_ENABLED) {
+                std::cerr << "--stats is unavailable: built with SAA_ENABLE_STATS=0\n";
+                return std::nullopt;
+            }
+            if (value != "text" && value != "json") {
+                std::cerr << "Invalid stats format: " << value << " (expected text or json)\n";
+                return std::nullopt;
+            }
+            options.statisticsFormat = value == "json"
+                ? presentation::controllers::StatisticsFormat::Json
+                : presentation::controllers::StatisticsFormat::Text;
+        } else if (arg == "--allocator" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            if (value != "arena" && value != "heap") {
+                std::cerr << "Invalid allocator: " << value << " (expected arena or heap)\n";
+                return std::nullopt;
+            }
+            options.runArena = value == "arena";
+        } else if (arg == "--categories" && i + 1 < argc) {
+            std::string_view value = argv[++i];
+            for (std::size_t begin = 0; begin <= value.size();) {
+                const auto end = std::min(value.find(',', begin), value.size());
+                options.categories.emplace_back(value.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n"
+                      << "Usage: StudentActivityAssignment [--threads N] [--seed S] [--loader mmap|stream]"
+                      << " [--stream] [--chunk-size N] [--output PATH] [--format csv|jsonl|binary]"
+                      << " [--capacity] [--strategy standard|weighted|balanced] [--state PATH]"
+                      << " [--daemon] [--serve SOCKET] [--stats text|json] [--allocator arena|heap]"
+                      << " [--categories A,B,...]\n";
+            return std::nullopt;
+        }
+    }
+
+    // Incremental mode cần cả roster để diff với state
+    if (options.statePath && options.streamChunkSize > 0) {
+        std::cerr << "--state cannot be combined with --stream or --chunk-size\n";
+        return std::nullopt;
+    }
+    return options;
+}
+} // namespace app::config
+
 namespace app::factory {
 
 // Factory class để create application dependencies
 class ApplicationFactory {
 public:
+    // Output repository theo format, chạy trên background writer thread
+    [[nodiscard]] static std::unique_ptr<domain::repositories::IAssignmentRepository>
+    createAssignmentRepository(const std::string& path, std::string_view format)
+    {
+        std::unique_ptr<domain::repositories::IAssignmentRepository> repository;
+        if (format == "jsonl") {
+            repository = domain::repositories::createJsonLinesAssignmentRepository(path);
+        } else if (format == "binary") {
+            repository = domain::repositories::createBinaryAssignmentRepository(path);
+        } else {
+            repository = domain::repositories::createCsvAssignmentRepository(path);
+        }
+        return domain::repositories::createAsyncAssignmentRepository(
+            std::move(repository), app::config::OUTPUT_QUEUE_CAPACITY);
+    }
+
+    // Strategy theo tên trong options
+    [[nodiscard]] static std::unique_ptr<application::strategies::IRandomSelectionStrategy>
+    createStrategy(std::string_view name, std::uint64_t seed)
+    {
+        if (name == "weighted") {
+            return application::strategies::createWeightedRandomStrategy(seed);
+        }
+        if (name == "balanced") {
+            return application::strategies::createBalancedRandomStrategy(seed);
+        }
+        return application::strategies::createStandardRandomStrategy(seed);
+    }
+
     // if constexpr template để choose strategy based on template parameter
     template <bool UseWeightedStrategy = false>
-    [[nodiscard]] static std::unique_ptr<presentation::controllers::ActivityAssignmentController>
-    createController()
+    [[nodiscard]] static std::unique_ptr<application::services::ActivityAssignmentService>
+    createService(const app::config::Options& options)
     {
-
-        // Create repositories
-        auto studentRepo = domain::repositories::createFileStudentRepository(
-            std::string { app::config::STUDENTS_FILE });
+        // Create repositories; mmap roster và catalog được parse trên cùng số threads với assignment
+        auto studentRepo = options.mappedRoster
+            ? domain::repositories::createMappedStudentRepository(
+                  std::string { app::config::STUDENTS_FILE }, options.threadCount)
+            : domain::repositories::createFileStudentRepository(std::string { app::config::STUDENTS_FILE });
         auto activityRepo = domain::repositories::createFileActivityRepository(
-            std::string { app::config::ACTIVITIES_FILE });
+            std::string { app::config::ACTIVITIES_FILE }, options.threadCount);
+
+        // Daemon: repeated loads chỉ tốn một stat khi files không đổi
+        if (options.daemon) {
+            studentRepo = domain::repositories::createCachingStudentRepository(
+                std::move(studentRepo), std::string { app::config::STUDENTS_FILE }, options.threadCount);
+            activityRepo = domain::repositories::createCachingActivityRepository(
+                std::move(activityRepo), std::string { app::config::ACTIVITIES_FILE }, options.threadCount);
+        }
 
         // Create strategy based on template parameter (if constexpr - C++17)
+        const std::uint64_t seed = options.seed ? *options.seed : application::strategies::generateRandomSeed();
         std::unique_ptr<application::strategies::IRandomSelectionStrategy> strategy;
         if constexpr (UseWeightedStrategy) {
-            strategy = application::strategies::createWeightedRandomStrategy();
+            strategy = application::strategies::createWeightedRandomStrategy(seed);
         } else {
-            strategy = application::strategies::createStandardRandomStrategy();
+            strategy = createStrategy(options.strategy, seed);
         }
 
         // Create service with dependency injection
         auto service = std::make_unique<application::services::ActivityAssignmentService>(
             std::move(studentRepo), std::move(activityRepo), std::move(strategy));
+        service->setThreadCount(options.threadCount);
+        service->setCapacityConstrained(options.capacityConstrained);
+        service->setResidentMode(options.daemon);
+        service->setRunArena(options.runArena);
+        return service;
+    }
 
-        // Create controller
-        return std::make_unique<presentation::controllers::ActivityAssignmentController>(
-            std::move(service));
+    template <bool UseWeightedStrategy = false>
+    [[nodiscard]] static std::unique_ptr<presentation::controllers::ActivityAssignmentController>
+    createController(const app::config::Options& options)
+    {
+        auto controller = std::make_unique<presentation::controllers::ActivityAssignmentController>(
+            createService<UseWeightedStrategy>(options));
+        if (options.streamChunkSize > 0) {
+            controller->enableStreaming(options.streamChunkSize);
+        }
+        if (options.statePath) {
+            controller->enableIncremental(
+                domain::repositories::createFileAssignmentStateRepository(*options.statePath));
+        }
+        if (options.outputPath) {
+            controller->setAssignmentRepository(createAssignmentRepository(*options.outputPath, options.outputFormat));
+        }
+        if (options.statisticsFormat) {
+            controller->enableStatistics(*options.statisticsFormat);
+        }
+        return controller;
     }
 };
 
 } // namespace app::factory
 
-int main()
+int main(int argc, char* argv[])
 {
     try {
+        auto options = app::config::parseArguments(argc, argv);
+        if (!options) {
+            return 1;
+        }
+
+        if (options->statisticsFormat) {
+            application::services::enableAllocationCounting();
+        }
+
+        // Categories ngoài danh sách là lỗi của catalog load, kể cả sau hot reloads
+        if (!options->categories.empty()
+            && !domain::entities::Activity::restrictCategories(options->categories)) {
+            std::cerr << "Invalid --categories list (empty name or reserved character)\n";
+            return 1;
+        }
+
+        // Server mode: assign một lần, rồi serve lookups tới khi SIGINT/SIGTERM
+        if (options->serveSocket) {
+            auto service = app::factory::ApplicationFactory::createService<false>(*options);
+            std::clog << "server: " << service->getCurrentStrategyInfo()
+                      << ", seed " << service->getCurrentSeed() << "\n";
+            presentation::server::QueryServer server(std::move(service), *options->serveSocket);
+            if (auto served = server.run(); !served) {
+                std::cerr << "Error: " << served.error() << "\n";
+                return 1;
+            }
+            return 0;
+        }
+
         std::cout << "Student Activity Assignment System\n";
         std::cout << "==================================\n\n";
 
-        // Create controller với standard strategy
-        auto controller = app::factory::ApplicationFactory::createController<false>();
+        // Create controller với strategy từ --strategy
+        auto controller = app::factory::ApplicationFactory::createController<false>(*options);
 
         // Display strategy info
         controller->displayServiceInfo();
         std::cout << "\n";
 
+        if (options->daemon) {
+            const std::filesystem::path studentsFile { app::config::STUDENTS_FILE };
+            const std::filesystem::path activitiesFile { app::config::ACTIVITIES_FILE };
+            presentation::daemon::AssignmentDaemon daemon(std::move(controller),
+                studentsFile.parent_path().string(),
+                studentsFile.filename().string(),
+                activitiesFile.filename().string());
+            return daemon.run() ? 0 : 1;
+        }
+
         // Execute assignment
         bool success = controller->execute();
 
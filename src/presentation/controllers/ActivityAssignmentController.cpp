@@ -1,25 +1,80 @@
 #include "ActivityAssignmentController.h"
+#include <algorithm>
+#include <array>
+#include <iomanip>
 #include <iostream>
+#include <optional>
 
 namespace presentation::controllers {
 
+namespace {
+
+// Số students mỗi batch gửi tới assignment repository
+constexpr std::size_t OUTPUT_BATCH_SIZE = 65536;
+
+} // namespace
+
 ActivityAssignmentController::ActivityAssignmentController(
     std::unique_ptr<application::services::ActivityAssignmentService> service)
     : service_(std::move(service))
 {
 }
 
+void ActivityAssignmentController::enableStreaming(std::size_t chunkSize) noexcept
+{
+    streamChunkSize_ = chunkSize;
+}
+
+void ActivityAssignmentController::setAssignmentRepository(
+    std::unique_ptr<domain::repositories::IAssignmentRepository> repository) noexcept
+{
+    assignmentRepo_ = std::move(repository);
+}
+
+void ActivityAssignmentController::enableIncremental(
+    std::unique_ptr<domain::repositories::IAssignmentStateRepository> stateRepository) noexcept
+{
+    stateRepo_ = std::move(stateRepository);
+}
+
+void ActivityAssignmentController::enableStatistics(StatisticsFormat format) noexcept
+{
+    statisticsFormat_ = format;
+}
+
 bool ActivityAssignmentController::execute() const noexcept
 {
     try {
+        if (stateRepo_) {
+            return executeIncremental();
+        }
+        if (streamChunkSize_ > 0) {
+            return executeStreaming();
+        }
+
+        const auto before = application::services::snapshotCounters();
         auto result = service_->assignActivitiesToStudents();
 
         if (!result) {
-            displayError("Failed to assign activities to students");
+            displayAssignmentFailure();
+            return false;
+        }
+        reportNewCategories(result->catalog);
+
+        application::services::PhaseTimer outputTimer { result->statistics, application::services::RunPhase::Output };
+        if (assignmentRepo_) {
+            if (!saveResults(result->catalog, *result->students, result->results)) {
+                return false;
+            }
+        } else if (!displayResults(*result)) {
             return false;
         }
+        outputTimer.stop();
 
-        displayResults(*result);
+        if (!result->workerStats.empty()) {
+            displayWorkerStats(result->workerStats);
+        }
+        displayStatistics(result->statistics, before);
         return true;
 
     } catch (const std::exception& e) {
@@ -31,20 +86,328 @@ bool ActivityAssignmentController::execute() const noexcept
     }
 }
 
+bool ActivityAssignmentController::executeStreaming() const
+{
+    // Writer được tạo ở chunk đầu tiên (labels render một lần cho catalog);
+    // mỗi chunk được in và flush ngay, trước khi đọc chunk tiếp theo
+    const auto before = application::services::snapshotCounters();
+    std::optional<writers::ResultWriter> writer;
+    bool repositoryOpen = false;
+    bool outputFailed = false;
+    auto summary = service_->assignActivitiesStreaming(streamChunkSize_,
+        [&](const application::services::ActivityAssignmentService::AssignmentChunk& chunk) {
+            reportNewCategories(chunk.catalog);
+            if (assignmentRepo_) {
+                // Async repository: chunk được enqueue, chunk tiếp theo compute trong lúc ghi
+                if (!repositoryOpen) {
+                    if (auto opened = assignmentRepo_->open(chunk.catalog); !opened) {
+                        displayError(opened.error());
+                        return false;
+                    }
+                    repositoryOpen = true;
+                }
+                return saveBatches(chunk.students, chunk.results);
+            }
+
+            if (!writer) {
+                writer.emplace(std::cout, chunk.catalog);
+            }
+            writer->write(chunk.students, chunk.results);
+            if (!writer->flush()) {
+                displayError("Failed to write results to stdout");
+                outputFailed = true;
+                return false;
+            }
+            return true;
+        });
+
+    // Async repository drain phần còn lại trong close(): tính vào output phase
+    std::optional<application::services::PhaseTimer> closeTimer;
+    if (summary) {
+        closeTimer.emplace(summary->statistics, application::services::RunPhase::Output);
+    }
+    if (repositoryOpen) {
+        if (auto closed = assignmentRepo_->close(); !closed) {
+            displayError(closed.error());
+            return false;
+        }
+    }
+    closeTimer.reset();
+
+    if (!summary) {
+        // Lỗi ghi output đã được report trong callback
+        if (!outputFailed) {
+            displayAssignmentFailure();
+        }
+        return false;
+    }
+
+    if (!summary->workerStats.empty()) {
+        displayWorkerStats(summary->workerStats);
+    }
+    if (writer) {
+        displayWriterStats(*writer);
+    }
+    displayStatistics(summary->statistics, before);
+    return true;
+}
+
+bool ActivityAssignmentController::executeIncremental() const
+{
+    const auto before = application::services::snapshotCounters();
+    auto previous = stateRepo_->loadState();
+    if (!previous) {
+        displayError(previous.error());
+        return false;
+    }
+
+    auto result = service_->assignActivitiesIncrementally(*previous);
+    if (!result) {
+        displayAssignmentFailure();
+        return false;
+    }
+
+    auto& assignment = result->assignment;
+    reportNewCategories(assignment.catalog);
+    application::services::PhaseTimer outputTimer { assignment.statistics, application::services::RunPhase::Output };
+    if (assignmentRepo_) {
+        if (!saveResults(assignment.catalog, *assignment.students, assignment.results)) {
+            return false;
+        }
+    } else if (!displayResults(assignment)) {
+        return false;
+    }
+
+    // State chỉ được replace sau khi output thành công
+    if (auto saved = stateRepo_->saveState(result->state); !saved) {
+        displayError(saved.error());
+        return false;
+    }
+    outputTimer.stop();
+
+    displayIncrementalStats(result->stats);
+    if (!assignment.workerStats.empty()) {
+        displayWorkerStats(assignment.workerStats);
+    }
+    displayStatistics(assignment.statistics, before);
+    return true;
+}
+
+bool ActivityAssignmentController::saveResults(
+    const domain::entities::ActivityIndex& catalog,
+    std::span<const domain::entities::Student> students,
+    application::services::ActivityAssignmentService::AssignmentRows results) const
+{
+    if (auto opened = assignmentRepo_->open(catalog); !opened) {
+        displayError(opened.error());
+        return false;
+    }
+
+    const bool saved = saveBatches(students, results);
+
+    if (auto closed = assignmentRepo_->close(); !closed) {
+        displayError(closed.error());
+        return false;
+    }
+    return saved;
+}
+
+bool ActivityAssignmentController::saveBatches(
+    std::span<const domain::entities::Student> students,
+    application::services::ActivityAssignmentService::AssignmentRows results) const
+{
+    for (std::size_t begin = 0; begin < results.size(); begin += OUTPUT_BATCH_SIZE) {
+        const std::size_t count = std::min(OUTPUT_BATCH_SIZE, results.size() - begin);
+
+        // Results đã row-major: batch là copy contiguous của range
+        const auto rows = results.subspan(begin, count);
+        domain::repositories::AssignmentBatch batch;
+        batch.categoriesPerStudent = rows.categoryCount();
+        batch.students.assign(students.begin() + begin, students.begin() + begin + count);
+        batch.activityIds.assign(rows.activityIds().begin(), rows.activityIds().end());
+
+        if (auto saved = assignmentRepo_->saveAssignments(std::move(batch)); !saved) {
+            displayError(saved.error());
+            return false;
+        }
+    }
+    return true;
+}
+
 void ActivityAssignmentController::displayServiceInfo() const noexcept
 {
     std::cout << "Current strategy: " << service_->getCurrentStrategyInfo() << "\n";
+    std::cout << "Seed: " << service_->getCurrentSeed() << "\n";
+    if (service_->isCapacityConstrained()) {
+        std::cout << "Capacity limits: enforced\n";
+    }
+}
+
+bool ActivityAssignmentController::preloadRoster() const noexcept
+{
+    try {
+        return service_->preloadRoster();
+    } catch (const std::exception& e) {
+        displayError(e.what());
+        return false;
+    }
+}
+
+bool ActivityAssignmentController::preloadCatalog() const noexcept
+{
+    try {
+        if (service_->preloadCatalog()) {
+            return true;
+        }
+        if (auto reason = service_->getLastError(); !reason.empty()) {
+            displayError(reason);
+        }
+        return false;
+    } catch (const std::exception& e) {
+        displayError(e.what());
+        return false;
+    }
+}
+
+bool ActivityAssignmentController::displayResults(
+    const application::services::ActivityAssignmentService::AssignmentSet& assignment) const noexcept
+{
+    // Names được resolve từ shared catalog chỉ tại output time
+    writers::ResultWriter writer(std::cout, assignment.catalog);
+    writer.write(*assignment.students, assignment.results);
+    if (!writer.flush()) {
+        displayError("Failed to write results to stdout");
+        return false;
+    }
+
+    displayWriterStats(writer);
+    return true;
+}
+
+void ActivityAssignmentController::displayWorkerStats(
+    const std::vector<application::services::ActivityAssignmentService::WorkerStats>& stats) const noexcept
+{
+    // Diagnostics đi qua std::clog để stdout chỉ chứa results
+    for (const auto& worker : stats) {
+        std::clog << "Worker " << worker.workerIndex << ": "
+                  << worker.studentCount << " students in "
+                  << std::fixed << std::setprecision(3)
+                  << std::chrono::duration<double, std::milli>(worker.elapsed).count() << " ms ("
+                  << std::setprecision(0) << worker.studentsPerSecond() << " students/s)\n"
+                  << std::defaultfloat;
+    }
+}
+
+void ActivityAssignmentController::displayWriterStats(const writers::ResultWriter& writer) const noexcept
+{
+    std::clog << "Output: " << writer.getLinesWritten() << " lines, "
+              << writer.getBytesWritten() << " bytes in "
+              << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double, std::milli>(writer.getElapsed()).count() << " ms ("
+              << std::setprecision(0) << writer.getLinesPerSecond() << " lines/s, target "
+              << writers::ResultWriter::TARGET_LINES_PER_SECOND << ")\n"
+              << std::defaultfloat;
+}
+
+void ActivityAssignmentController::displayIncrementalStats(
+    const application::services::ActivityAssignmentService::IncrementalStats& stats) const noexcept
+{
+    std::clog << "Incremental: " << stats.keptCount << " kept, "
+              << stats.assignedCount << " assigned, "
+              << stats.removedCount << " removed\n";
+}
+
+void ActivityAssignmentController::displayStatistics(application::services::RunStatistics statistics,
+    const application::services::CounterSnapshot& before) const noexcept
+{
+    using application::services::RunPhase;
+
+    if (!statisticsFormat_) {
+        return;
+    }
+    statistics.counters = application::services::snapshotCounters() - before;
+
+    auto milliseconds = [](std::chrono::nanoseconds elapsed) {
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+    constexpr std::array phases = {
+        RunPhase::Load, RunPhase::Validate, RunPhase::Assign, RunPhase::Capacity, RunPhase::Output
+    };
+    const auto& counters = statistics.counters;
+
+    std::clog << std::fixed << std::setprecision(3);
+    if (*statisticsFormat_ == StatisticsFormat::Json) {
+        std::clog << "{\"students\":" << statistics.studentCount
+                  << ",\"total_ms\":" << milliseconds(statistics.getTotalTime())
+                  << ",\"students_per_second\":" << std::setprecision(0) << statistics.studentsPerSecond()
+                  << std::setprecision(3) << ",\"phases_ms\":{";
+        for (std::size_t i = 0; i < phases.size(); ++i) {
+            std::clog << (i > 0 ? "," : "") << '"' << application::services::phaseName(phases[i]) << "\":"
+                      << milliseconds(statistics.getPhaseTime(phases[i]));
+        }
+        std::clog << "},\"draws\":{";
+        for (std::size_t c = 0; c < statistics.drawsPerCategory.size(); ++c) {
+            std::clog << (c > 0 ? "," : "") << '"'
+                      << domain::entities::Activity::categoryToString(statistics.categories[c])
+                      << "\":" << statistics.drawsPerCategory[c];
+        }
+        std::clog << "},\"capacity_redirects\":" << statistics.capacityRedirects
+                  << ",\"allocations\":" << counters.allocationCount
+                  << ",\"allocated_bytes\":" << counters.allocatedBytes
+                  << ",\"bytes_read\":" << counters.bytesRead
+                  << ",\"bytes_written\":" << counters.bytesWritten << "}\n";
+    } else {
+        std::clog << "Statistics: " << statistics.studentCount << " students in "
+                  << milliseconds(statistics.getTotalTime()) << " ms ("
+                  << std::setprecision(0) << statistics.studentsPerSecond() << " students/s)\n"
+                  << std::setprecision(3);
+        for (auto phase : phases) {
+            std::clog << "  " << std::left << std::setw(9) << application::services::phaseName(phase)
+                      << std::right << std::setw(12) << milliseconds(statistics.getPhaseTime(phase)) << " ms\n";
+        }
+        std::clog << "  draws:";
+        for (std::size_t c = 0; c < statistics.drawsPerCategory.size(); ++c) {
+            std::clog << " " << domain::entities::Activity::categoryToString(statistics.categories[c])
+                      << "=" << statistics.drawsPerCategory[c];
+        }
+        std::clog << ", capacity redirects=" << statistics.capacityRedirects << "\n"
+                  << "  allocations: " << counters.allocationCount << " (" << counters.allocatedBytes << " bytes)\n"
+                  << "  I/O: " << counters.bytesRead << " bytes read, " << counters.bytesWritten << " bytes written\n";
+    }
+    std::clog << std::defaultfloat;
+}
+
+void ActivityAssignmentController::reportNewCategories(const domain::entities::ActivityIndex& catalog) const
+{
+    if (domain::entities::Activity::categoriesRestricted()) {
+        return;
+    }
+
+    // Ids tăng dần theo thứ tự intern: ids từ reportedCategoryIds_ trở đi chưa được report
+    std::string names;
+    std::size_t nextUnreported = reportedCategoryIds_;
+    for (const auto category : catalog.getCategories()) {
+        const auto id = static_cast<std::size_t>(category);
+        if (id < reportedCategoryIds_) {
+            continue;
+        }
+        names.append(names.empty() ? "" : ", ").append(domain::entities::Activity::categoryToString(category));
+        nextUnreported = std::max(nextUnreported, id + 1);
+    }
+    reportedCategoryIds_ = nextUnreported;
+
+    if (!names.empty()) {
+        std::clog << "New categories: " << names << " (use --categories to reject unknown names)\n";
+    }
 }
 
-void ActivityAssignmentController::displayResults(
-    const std::vector<application::services::ActivityAssignmentService::AssignmentResult>& results) const noexcept
+void ActivityAssignmentController::displayAssignmentFailure() const
 {
-    for (const auto& [student, activities] : results) { // C++17 Structured Bindings
-        std::cout << student.getId() << ": "
-                  << activities[0].getFormattedActivity() << ", "
-                  << activities[1].getFormattedActivity() << ", "
-                  << activities[2].getFormattedActivity() << "\n";
+    std::string message = "Failed to assign activities to students";
+    if (auto reason = service_->getLastError(); !reason.empty()) {
+        message.append(": ").append(reason);
     }
+    displayError(message);
 }
 
 void ActivityAssignmentController::displayError(const std::string& error) const noexcept
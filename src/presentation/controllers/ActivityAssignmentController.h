@@ -1,31 +1,115 @@
 #pragma once
 
 #include "../../application/services/ActivityAssignmentService.h"
+#include "../../domain/repositories/IAssignmentRepository.h"
+#include "../../domain/repositories/IAssignmentStateRepository.h"
+#include "../writers/ResultWriter.h"
+#include <cstddef>
 #include <expected>
+#include <span>
 #include <string>
 #include <memory>
+#include <optional>
 
 namespace presentation::controllers {
 
+// Format của run statistics (--stats)
+enum class StatisticsFormat {
+    Text,
+    Json
+};
+
 // Controller class theo Clean Architecture
 class ActivityAssignmentController {
 private:
     std::unique_ptr<application::services::ActivityAssignmentService> service_;
 
+    // 0 = batch mode; > 0 = streaming mode với chunk size này
+    std::size_t streamChunkSize_ = 0;
+
+    // Optional output repository; không set thì results được in ra stdout
+    std::unique_ptr<domain::repositories::IAssignmentRepository> assignmentRepo_;
+
+    // Set thì chạy incremental mode với persisted state này
+    std::unique_ptr<domain::repositories::IAssignmentStateRepository> stateRepo_;
+
+    // Set thì report per-phase timing và counters sau mỗi run
+    std::optional<StatisticsFormat> statisticsFormat_;
+
+    // Category ids nhỏ hơn giá trị này đã được report (built-ins không cần report)
+    mutable std::size_t reportedCategoryIds_ = domain::entities::BUILTIN_CATEGORIES.size();
+
 public:
     explicit ActivityAssignmentController(
         std::unique_ptr<application::services::ActivityAssignmentService> service);
 
+    // Bật streaming mode: roster được đọc, assign và in theo chunks
+    void enableStreaming(std::size_t chunkSize) noexcept;
+
+    // Ghi results vào repository thay vì stdout
+    void setAssignmentRepository(
+        std::unique_ptr<domain::repositories::IAssignmentRepository> repository) noexcept;
+
+    // Bật incremental mode: chỉ assign delta của roster so với state, rồi lưu state mới
+    void enableIncremental(
+        std::unique_ptr<domain::repositories::IAssignmentStateRepository> stateRepository) noexcept;
+
+    // Report per-phase timing, throughput, draws, allocations và I/O bytes qua std::clog
+    void enableStatistics(StatisticsFormat format) noexcept;
+
     // Main execution method
     [[nodiscard]] bool execute() const noexcept;
 
     // Method để display service info
     void displayServiceInfo() const noexcept;
 
+    // Daemon hooks: load lại resident roster / catalog sau khi file thay đổi
+    [[nodiscard]] bool preloadRoster() const noexcept;
+    [[nodiscard]] bool preloadCatalog() const noexcept;
+
 private:
-    // Display results
-    void displayResults(
-        const std::vector<application::services::ActivityAssignmentService::AssignmentResult>& results) const noexcept;
+    // Streaming execution path
+    [[nodiscard]] bool executeStreaming() const;
+
+    // Incremental execution path
+    [[nodiscard]] bool executeIncremental() const;
+
+    // Open repository, save tất cả results theo batches, close
+    [[nodiscard]] bool saveResults(
+        const domain::entities::ActivityIndex& catalog,
+        std::span<const domain::entities::Student> students,
+        application::services::ActivityAssignmentService::AssignmentRows results) const;
+
+    // Save results vào repository đã open, theo batches
+    [[nodiscard]] bool saveBatches(
+        std::span<const domain::entities::Student> students,
+        application::services::ActivityAssignmentService::AssignmentRows results) const;
+
+    // Display results và writer stats; false (đã report lỗi) nếu ghi stdout thất bại
+    [[nodiscard]] bool displayResults(
+        const application::services::ActivityAssignmentService::AssignmentSet& assignment) const noexcept;
+
+    // Display per-worker throughput của parallel run
+    void displayWorkerStats(
+        const std::vector<application::services::ActivityAssignmentService::WorkerStats>& stats) const noexcept;
+
+    // Display delta của incremental run
+    void displayIncrementalStats(
+        const application::services::ActivityAssignmentService::IncrementalStats& stats) const noexcept;
+
+    // Display output throughput của result writer
+    void displayWriterStats(const writers::ResultWriter& writer) const noexcept;
+
+    // Display run statistics; counters là delta từ snapshot trước run
+    void displayStatistics(application::services::RunStatistics statistics,
+        const application::services::CounterSnapshot& before) const noexcept;
+
+    // Report categories ngoài built-ins xuất hiện lần đầu trong process, để typo trong
+    // activities.txt không âm thầm thành category mới (không report khi có --categories)
+    void reportNewCategories(const domain::entities::ActivityIndex& catalog) const;
+
+    // Display lỗi của run, kèm lý do từ catalog load nếu có
+    void displayAssignmentFailure() const;
 
     // Display error với std::string
     void displayError(const std::string& error) const noexcept;
@@ -0,0 +1,166 @@
+#include "AssignmentDaemon.h"
+#include "../../infrastructure/utils/DirectoryWatcher.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace presentation::daemon {
+
+namespace {
+
+// Milliseconds từ start tới hiện tại, cho status messages
+[[nodiscard]] double elapsedMilliseconds(std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+AssignmentDaemon::AssignmentDaemon(
+    std::unique_ptr<controllers::ActivityAssignmentController> controller,
+    std::string dataDirectory,
+    std::string rosterFileName,
+    std::string catalogFileName)
+    : controller_(std::move(controller))
+    , dataDirectory_(std::move(dataDirectory))
+    , rosterFileName_(std::move(rosterFileName))
+    , catalogFileName_(std::move(catalogFileName))
+{
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+bool AssignmentDaemon::run()
+{
+    reloadRoster();
+    reloadCatalog();
+
+    // Không có inotify thì caching repositories vẫn revalidate bằng stat mỗi run
+    auto watcher = infrastructure::utils::DirectoryWatcher::open(dataDirectory_);
+    if (!watcher) {
+        std::clog << "daemon: hot reload unavailable for " << dataDirectory_ << "\n";
+    }
+
+    std::cout.flush();
+    std::clog << "daemon: ready (commands: run, reload, quit)\n";
+
+    pollfd descriptors[2] = {
+        { .fd = STDIN_FILENO, .events = POLLIN, .revents = 0 },
+        { .fd = watcher ? watcher->fileDescriptor() : -1, .events = POLLIN, .revents = 0 }
+    };
+
+    std::string input;
+    char buffer[4096];
+    for (;;) {
+        if (::poll(descriptors, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        if (descriptors[1].revents & POLLIN) {
+            handleChanges(watcher->readChanges());
+        }
+
+        if (descriptors[0].revents & (POLLIN | POLLHUP)) {
+            const ssize_t length = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+            if (length <= 0) {
+                return true; // EOF
+            }
+            input.append(buffer, static_cast<std::size_t>(length));
+
+            for (auto newline = input.find('\n'); newline != std::string::npos; newline = input.find('\n')) {
+                const std::string line = input.substr(0, newline);
+                input.erase(0, newline + 1);
+                if (!handleCommand(line)) {
+                    return true;
+                }
+            }
+        }
+    }
+}
+
+#else
+
+// Không có poll(): chỉ đọc commands, không hot reload
+bool AssignmentDaemon::run()
+{
+    reloadRoster();
+    reloadCatalog();
+    std::clog << "daemon: ready (commands: run, reload, quit)\n";
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (!handleCommand(line)) {
+            break;
+        }
+    }
+    return true;
+}
+
+#endif
+
+bool AssignmentDaemon::handleCommand(std::string_view command) const
+{
+    // Trim whitespace và '\r' của CRLF input
+    const auto first = command.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) {
+        return true;
+    }
+    command = command.substr(first, command.find_last_not_of(" \t\r") - first + 1);
+
+    if (command == "quit") {
+        return false;
+    }
+
+    if (command == "run") {
+        const auto start = std::chrono::steady_clock::now();
+        const bool success = controller_->execute();
+        std::cout.flush();
+        std::clog << "run: " << (success ? "ok" : "failed") << " in "
+                  << elapsedMilliseconds(start) << " ms\n";
+    } else if (command == "reload") {
+        reloadRoster();
+        reloadCatalog();
+    } else {
+        std::clog << "unknown command: " << command << "\n";
+    }
+    return true;
+}
+
+void AssignmentDaemon::handleChanges(const std::vector<std::string>& fileNames) const
+{
+    // Một lần save có thể sinh nhiều events cho cùng file
+    if (std::ranges::find(fileNames, rosterFileName_) != fileNames.end()) {
+        reloadRoster();
+    }
+    if (std::ranges::find(fileNames, catalogFileName_) != fileNames.end()) {
+        reloadCatalog();
+    }
+}
+
+void AssignmentDaemon::reloadRoster() const
+{
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = controller_->preloadRoster();
+    std::clog << "reload: " << rosterFileName_ << (loaded ? " loaded" : " failed")
+              << " in " << elapsedMilliseconds(start) << " ms\n";
+}
+
+void AssignmentDaemon::reloadCatalog() const
+{
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = controller_->preloadCatalog();
+    std::clog << "reload: " << catalogFileName_ << (loaded ? " loaded" : " failed")
+              << " in " << elapsedMilliseconds(start) << " ms\n";
+}
+
+} // namespace presentation::daemon
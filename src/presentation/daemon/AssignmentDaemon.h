@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../controllers/ActivityAssignmentController.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace presentation::daemon {
+
+// Long-running mode: giữ roster, catalog và indexes resident trong controller/service,
+// hot reload khi files trong dataDirectory thay đổi (inotify), và chạy assignment
+// theo commands từ stdin, mỗi dòng một command:
+//   run    - chạy assignment với resident data
+//   reload - load lại roster và catalog
+//   quit   - thoát (EOF trên stdin cũng vậy)
+// Status messages đi ra std::clog để stdout chỉ chứa results
+class AssignmentDaemon {
+private:
+    std::unique_ptr<controllers::ActivityAssignmentController> controller_;
+    std::string dataDirectory_;
+    std::string rosterFileName_;
+    std::string catalogFileName_;
+
+public:
+    AssignmentDaemon(
+        std::unique_ptr<controllers::ActivityAssignmentController> controller,
+        std::string dataDirectory,
+        std::string rosterFileName,
+        std::string catalogFileName);
+
+    // Chạy tới khi quit/EOF; false nếu event loop fail
+    [[nodiscard]] bool run();
+
+private:
+    // false khi command là quit
+    [[nodiscard]] bool handleCommand(std::string_view command) const;
+
+    // Chỉ reload structure ứng với file đã thay đổi
+    void handleChanges(const std::vector<std::string>& fileNames) const;
+
+    void reloadRoster() const;
+    void reloadCatalog() const;
+};
+
+} // namespace presentation::daemon
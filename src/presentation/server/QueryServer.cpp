@@ -0,0 +1,396 @@
+#include "QueryServer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace presentation::server {
+
+namespace {
+
+constexpr std::string_view ID_SEPARATOR = ": ";
+constexpr std::string_view LABEL_SEPARATOR = ", ";
+
+// Request line dài hơn giới hạn này thì đóng connection
+constexpr std::size_t MAX_REQUEST_LENGTH = std::size_t { 1 } << 20;
+
+// Ngừng đọc requests của client khi responses chờ gửi vượt quá giới hạn này
+constexpr std::size_t MAX_PENDING_OUTPUT = std::size_t { 4 } << 20;
+
+// Tách token đầu tiên (space-separated) khỏi input
+[[nodiscard]] std::string_view nextToken(std::string_view& input) noexcept
+{
+    const auto begin = input.find_first_not_of(' ');
+    if (begin == std::string_view::npos) {
+        input = {};
+        return {};
+    }
+    input.remove_prefix(begin);
+    const auto end = std::min(input.find(' '), input.size());
+    const auto token = input.substr(0, end);
+    input.remove_prefix(end);
+    return token;
+}
+
+#if defined(__linux__)
+
+// RAII owner của một file descriptor
+class FileDescriptor {
+private:
+    int fd_ = -1;
+
+public:
+    FileDescriptor() = default;
+    explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+    ~FileDescriptor()
+    {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+    FileDescriptor(FileDescriptor&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+    FileDescriptor& operator=(FileDescriptor&&) = delete;
+
+    [[nodiscard]] int get() const noexcept { return fd_; }
+    [[nodiscard]] bool valid() const noexcept { return fd_ >= 0; }
+};
+
+// Per-client buffers; output được gửi dần khi socket writable
+struct Connection {
+    FileDescriptor socket;
+    std::string input;
+    std::string output;
+    std::size_t outputOffset = 0;
+    bool inputClosed = false; // Client đã shutdown write side: đóng sau khi gửi hết output
+
+    [[nodiscard]] std::size_t pendingOutput() const noexcept { return output.size() - outputOffset; }
+};
+
+[[nodiscard]] std::string systemError(std::string_view what)
+{
+    return std::string { what } + ": " + std::strerror(errno);
+}
+
+#endif
+
+} // namespace
+
+QueryServer::QueryServer(
+    std::unique_ptr<application::services::ActivityAssignmentService> service,
+    std::string socketPath)
+    : service_(std::move(service))
+    , socketPath_(std::move(socketPath))
+{
+}
+
+std::shared_ptr<const QueryServer::Snapshot> QueryServer::buildSnapshot(
+    const application::services::ActivityAssignmentService& service)
+{
+    auto assignment = service.assignActivitiesToStudents();
+    if (!assignment) {
+        return nullptr;
+    }
+
+    return std::make_shared<const Snapshot>(Snapshot {
+        .lookup = application::services::AssignmentLookup { std::move(*assignment) } });
+}
+
+void QueryServer::handleRequest(std::string_view request, std::string& out)
+{
+    if (!request.empty() && request.back() == '\r') {
+        request.remove_suffix(1);
+    }
+
+    const auto command = nextToken(request);
+    if (command == "GET") {
+        const auto id = nextToken(request);
+        if (id.empty() || !nextToken(request).empty()) {
+            out += "ERROR GET takes one student id\n";
+            return;
+        }
+        appendLookup(*snapshot_.load(), id, out);
+    } else if (command == "MGET") {
+        // Một snapshot cho cả request để MGET nhất quán khi reload swap giữa chừng
+        const auto snapshot = snapshot_.load();
+        std::size_t count = 0;
+        for (auto id = nextToken(request); !id.empty(); id = nextToken(request)) {
+            appendLookup(*snapshot, id, out);
+            ++count;
+        }
+        if (count == 0) {
+            out += "ERROR missing student id\n";
+        }
+    } else if (command == "RELOAD") {
+        startReload(out);
+    } else if (!command.empty()) {
+        out += "ERROR unknown command: ";
+        out += command;
+        out += '\n';
+    }
+}
+
+void QueryServer::appendLookup(const Snapshot& snapshot, std::string_view studentId, std::string& out)
+{
+    const auto student = domain::entities::Student::parse(studentId);
+    if (!student) {
+        out += "ERROR invalid student id: ";
+        out += studentId;
+        out += '\n';
+        return;
+    }
+
+    const auto result = snapshot.lookup.find(student->getPackedId());
+    if (!result) {
+        out += "NOT_FOUND ";
+        out += studentId;
+        out += '\n';
+        return;
+    }
+
+    const auto& catalog = snapshot.lookup.getAssignment().catalog;
+    out += studentId;
+    out += ID_SEPARATOR;
+    bool first = true;
+    for (auto id : result->activityIds) {
+        if (!first) {
+            out += LABEL_SEPARATOR;
+        }
+        first = false;
+        out += catalog.getActivity(id).getFormattedActivity();
+    }
+    out += '\n';
+}
+
+void QueryServer::startReload(std::string& out)
+{
+    if (reloading_.exchange(true)) {
+        out += "ERROR reload in progress\n";
+        return;
+    }
+
+    // Thread trước đã xong (reloading_ false), assignment join nó
+    reloader_ = std::jthread([this] {
+        const auto start = std::chrono::steady_clock::now();
+        auto snapshot = buildSnapshot(*service_);
+        const bool built = snapshot != nullptr;
+        if (built) {
+            snapshot_.store(std::move(snapshot));
+        }
+        std::clog << "reload: " << (built ? "ok" : "failed") << " in "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                  << " ms";
+        if (const auto reason = built ? std::string {} : service_->getLastError(); !reason.empty()) {
+            std::clog << ": " << reason;
+        }
+        std::clog << "\n";
+        reloading_.store(false);
+    });
+    out += "OK reloading\n";
+}
+
+#if defined(__linux__)
+
+std::expected<void, std::string> QueryServer::run()
+{
+    // Block SIGINT/SIGTERM trước khi tạo threads; nhận chúng qua signalfd trong event loop
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    if (::pthread_sigmask(SIG_BLOCK, &signals, nullptr) != 0) {
+        return std::unexpected("Cannot block signals");
+    }
+    FileDescriptor signalFd { ::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC) };
+    if (!signalFd.valid()) {
+        return std::unexpected(systemError("signalfd"));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto snapshot = buildSnapshot(*service_);
+    if (!snapshot) {
+        return std::unexpected("Failed to assign activities to students");
+    }
+    std::clog << "server: " << snapshot->lookup.size() << " students indexed in "
+              << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+              << " ms\n";
+    snapshot_.store(std::move(snapshot));
+
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(address.sun_path)) {
+        return std::unexpected("Socket path too long: " + socketPath_);
+    }
+    std::memcpy(address.sun_path, socketPath_.c_str(), socketPath_.size() + 1);
+
+    FileDescriptor listener { ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0) };
+    if (!listener.valid()) {
+        return std::unexpected(systemError("socket"));
+    }
+
+    // Xoá socket file còn sót từ lần chạy trước
+    ::unlink(socketPath_.c_str());
+    if (::bind(listener.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listener.get(), SOMAXCONN) != 0) {
+        return std::unexpected(systemError("Cannot listen on " + socketPath_));
+    }
+
+    FileDescriptor epoll { ::epoll_create1(EPOLL_CLOEXEC) };
+    if (!epoll.valid()) {
+        return std::unexpected(systemError("epoll_create1"));
+    }
+
+    auto watch = [&](int op, int fd, std::uint32_t events) {
+        epoll_event event {};
+        event.events = events;
+        event.data.fd = fd;
+        return ::epoll_ctl(epoll.get(), op, fd, &event) == 0;
+    };
+
+    if (!watch(EPOLL_CTL_ADD, listener.get(), EPOLLIN) || !watch(EPOLL_CTL_ADD, signalFd.get(), EPOLLIN)) {
+        return std::unexpected(systemError("epoll_ctl"));
+    }
+
+    std::clog << "server: listening on " << socketPath_ << "\n";
+
+    std::unordered_map<int, Connection> connections;
+
+    // Gửi pending output; cập nhật interest set theo buffer còn lại. false nếu client lỗi
+    auto flush = [&](Connection& connection) {
+        while (connection.pendingOutput() > 0) {
+            const ssize_t sent = ::send(connection.socket.get(),
+                connection.output.data() + connection.outputOffset,
+                connection.pendingOutput(), MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return false;
+            }
+            connection.outputOffset += static_cast<std::size_t>(sent);
+        }
+        if (connection.pendingOutput() == 0) {
+            connection.output.clear();
+            connection.outputOffset = 0;
+        }
+
+        std::uint32_t events = 0;
+        if (!connection.inputClosed && connection.pendingOutput() < MAX_PENDING_OUTPUT) {
+            events |= EPOLLIN;
+        }
+        if (connection.pendingOutput() > 0) {
+            events |= EPOLLOUT;
+        }
+        return watch(EPOLL_CTL_MOD, connection.socket.get(), events);
+    };
+
+    // Đọc hết input có sẵn và xử lý các request lines hoàn chỉnh, kể cả khi client đã
+    // đóng write side (EOF). false nếu connection lỗi
+    auto receive = [&](Connection& connection) {
+        char buffer[16384];
+        for (;;) {
+            const ssize_t length = ::recv(connection.socket.get(), buffer, sizeof(buffer), 0);
+            if (length == 0) {
+                connection.inputClosed = true;
+                break;
+            }
+            if (length < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                return false;
+            }
+            connection.input.append(buffer, static_cast<std::size_t>(length));
+        }
+
+        std::size_t consumed = 0;
+        for (auto newline = connection.input.find('\n'); newline != std::string::npos;
+             newline = connection.input.find('\n', consumed)) {
+            handleRequest(std::string_view(connection.input).substr(consumed, newline - consumed),
+                connection.output);
+            consumed = newline + 1;
+        }
+        connection.input.erase(0, consumed);
+        return connection.input.size() <= MAX_REQUEST_LENGTH;
+    };
+
+    std::vector<epoll_event> events(64);
+    for (bool running = true; running;) {
+        const int ready = ::epoll_wait(epoll.get(), events.data(), static_cast<int>(events.size()), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return std::unexpected(systemError("epoll_wait"));
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+
+            if (fd == signalFd.get()) {
+                signalfd_siginfo info {};
+                while (::read(signalFd.get(), &info, sizeof(info)) == sizeof(info)) {}
+                running = false;
+                continue;
+            }
+
+            if (fd == listener.get()) {
+                for (;;) {
+                    const int client = ::accept4(listener.get(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (client < 0) {
+                        break;
+                    }
+                    connections.try_emplace(client, Connection { .socket = FileDescriptor { client }, .input = {}, .output = {}, .outputOffset = 0 });
+                    if (!watch(EPOLL_CTL_ADD, client, EPOLLIN)) {
+                        connections.erase(client);
+                    }
+                }
+                continue;
+            }
+
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+
+            auto& connection = it->second;
+            bool open = true;
+            if (events[i].events & EPOLLIN) {
+                open = receive(connection);
+            } else if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                open = false;
+            }
+            // Client đóng write side: connection còn mở tới khi responses đã được gửi hết
+            if (!flush(connection) || !open
+                || (connection.inputClosed && connection.pendingOutput() == 0)) {
+                connections.erase(it);
+            }
+        }
+    }
+
+    std::clog << "server: shutting down\n";
+    connections.clear();
+    ::unlink(socketPath_.c_str());
+    return {};
+}
+
+#else
+
+std::expected<void, std::string> QueryServer::run()
+{
+    return std::unexpected("Query server requires Linux (epoll)");
+}
+
+#endif
+
+} // namespace presentation::server
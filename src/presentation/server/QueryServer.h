@@ -0,0 +1,57 @@
+#pragma once
+
+#include "../../application/services/ActivityAssignmentService.h"
+#include "../../application/services/AssignmentLookup.h"
+#include <atomic>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace presentation::server {
+
+// Unix domain socket server cho low-latency assignment lookups, epoll event loop (Linux).
+// Line protocol, mỗi request một dòng, responses theo đúng thứ tự requests:
+//   GET <id>            -> "<id>: label, label, label" hoặc "NOT_FOUND <id>"
+//   MGET <id> <id> ...  -> một response line cho mỗi id
+//   RELOAD              -> "OK reloading"; assignment mới được swap vào khi build xong
+// Request không hợp lệ nhận "ERROR <message>". SIGINT/SIGTERM dừng server
+class QueryServer {
+public:
+    // Immutable snapshot, swap atomically khi reload. Labels đã được render sẵn
+    // trong name arena của catalog
+    struct Snapshot {
+        application::services::AssignmentLookup lookup;
+    };
+
+private:
+    std::unique_ptr<application::services::ActivityAssignmentService> service_;
+    std::string socketPath_;
+
+    std::atomic<std::shared_ptr<const Snapshot>> snapshot_;
+    std::atomic<bool> reloading_ { false };
+    std::jthread reloader_;
+
+public:
+    QueryServer(std::unique_ptr<application::services::ActivityAssignmentService> service,
+        std::string socketPath);
+
+    // Build snapshot đầu tiên rồi serve tới khi nhận SIGINT/SIGTERM
+    [[nodiscard]] std::expected<void, std::string> run();
+
+private:
+    [[nodiscard]] static std::shared_ptr<const Snapshot> buildSnapshot(
+        const application::services::ActivityAssignmentService& service);
+
+    // Append response của một request line vào out
+    void handleRequest(std::string_view request, std::string& out);
+
+    static void appendLookup(const Snapshot& snapshot, std::string_view studentId, std::string& out);
+
+    // Rebuild assignment trên background thread; lookups tiếp tục với snapshot cũ
+    void startReload(std::string& out);
+};
+
+} // namespace presentation::server
@@ -0,0 +1,104 @@
+#include "ResultWriter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace presentation::writers {
+
+namespace {
+
+constexpr std::string_view ID_SEPARATOR = ": ";
+constexpr std::string_view LABEL_SEPARATOR = ", ";
+
+} // namespace
+
+ResultWriter::ResultWriter(std::ostream& out,
+    const domain::entities::ActivityIndex& catalog,
+    std::size_t bufferSize)
+    : out_(out)
+{
+    labels_.reserve(catalog.size());
+    std::size_t maxLabelLength = 0;
+    for (const auto& activity : catalog.getActivities()) {
+        labels_.push_back(activity.getFormattedActivity());
+        maxLabelLength = std::max(maxLabelLength, labels_.back().size());
+    }
+
+    // Mỗi student một label per category của catalog
+    const std::size_t labelsPerLine = std::max<std::size_t>(catalog.categoryCount(), 1);
+    maxLineLength_ = domain::entities::Student::ID_LENGTH + ID_SEPARATOR.size()
+        + labelsPerLine * maxLabelLength + (labelsPerLine - 1) * LABEL_SEPARATOR.size() + 1;
+
+    buffer_.resize(std::max(bufferSize, maxLineLength_));
+}
+
+ResultWriter::~ResultWriter()
+{
+    flush();
+}
+
+void ResultWriter::write(std::span<const domain::entities::Student> students, AssignmentRows results)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (std::size_t k = 0; k < results.size(); ++k) {
+        if (buffer_.size() - used_ < maxLineLength_) {
+            flushBuffer();
+        }
+
+        char* cursor = buffer_.data() + used_;
+        students[k].writeId(std::span<char, domain::entities::Student::ID_LENGTH>(
+            cursor, domain::entities::Student::ID_LENGTH));
+        cursor += domain::entities::Student::ID_LENGTH;
+        std::memcpy(cursor, ID_SEPARATOR.data(), ID_SEPARATOR.size());
+        cursor += ID_SEPARATOR.size();
+
+        bool first = true;
+        for (auto id : results[k].activityIds) {
+            if (!first) {
+                std::memcpy(cursor, LABEL_SEPARATOR.data(), LABEL_SEPARATOR.size());
+                cursor += LABEL_SEPARATOR.size();
+            }
+            first = false;
+
+            const auto label = labels_[id];
+            std::memcpy(cursor, label.data(), label.size());
+            cursor += label.size();
+        }
+        *cursor++ = '\n';
+
+        used_ = static_cast<std::size_t>(cursor - buffer_.data());
+    }
+
+    linesWritten_ += results.size();
+    elapsed_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+}
+
+bool ResultWriter::flush()
+{
+    const auto start = std::chrono::steady_clock::now();
+    flushBuffer();
+    out_.flush();
+    elapsed_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    return static_cast<bool>(out_);
+}
+
+void ResultWriter::flushBuffer()
+{
+    if (used_ > 0) {
+        // Một write lớn per block
+        out_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+        bytesWritten_ += used_;
+        application::services::recordBytesWritten(used_);
+        used_ = 0;
+    }
+}
+
+double ResultWriter::getLinesPerSecond() const noexcept
+{
+    const auto seconds = std::chrono::duration<double>(elapsed_).count();
+    return seconds > 0.0 ? static_cast<double>(linesWritten_) / seconds : 0.0;
+}
+
+} // namespace presentation::writers
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../application/services/ActivityAssignmentService.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace presentation::writers {
+
+// Buffered writer cho assignment results.
+// Label "Name (Category)" của mỗi activity đã được render sẵn trong name arena của catalog
+// (catalog phải outlive writer); mỗi line được append
+// bằng memcpy vào reusable buffer và flush bằng một write lớn per block.
+class ResultWriter {
+public:
+    using AssignmentRows = application::services::ActivityAssignmentService::AssignmentRows;
+
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = std::size_t { 1 } << 20;
+
+    // Throughput target cho output path (đo bằng getLinesPerSecond())
+    static constexpr double TARGET_LINES_PER_SECOND = 10'000'000.0;
+
+    ResultWriter(std::ostream& out,
+        const domain::entities::ActivityIndex& catalog,
+        std::size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~ResultWriter();
+
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    // Append lines "ID: label, label, ..." (một label per category); students[k] ứng với results[k]
+    void write(std::span<const domain::entities::Student> students, AssignmentRows results);
+
+    // Flush buffer ra stream; false nếu stream lỗi
+    bool flush();
+
+    [[nodiscard]] std::uint64_t getLinesWritten() const noexcept { return linesWritten_; }
+    [[nodiscard]] std::uint64_t getBytesWritten() const noexcept { return bytesWritten_; }
+    [[nodiscard]] std::chrono::nanoseconds getElapsed() const noexcept { return elapsed_; }
+    [[nodiscard]] double getLinesPerSecond() const noexcept;
+
+private:
+    // Write buffer ra stream, không flush stream
+    void flushBuffer();
+
+    std::ostream& out_;
+
+    // Label views theo activity id, trỏ vào name arena của catalog
+    std::vector<std::string_view> labels_;
+    std::size_t maxLineLength_ = 0;
+
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+
+    std::uint64_t linesWritten_ = 0;
+    std::uint64_t bytesWritten_ = 0;
+    std::chrono::nanoseconds elapsed_ {};
+};
+
+} // namespace presentation::writers
@@ -0,0 +1,476 @@
+// Benchmark suite cho core library: roster/catalog parsing (tuần tự và song song với
+// --threads T > 1), per-draw và batch cost của
+// mỗi strategy, compile-time kernel so với virtual path, full assignActivitiesToStudents()
+// (run arena so với default allocator), scaling theo số categories và result output, ở
+// roster sizes 10^3 .. 10^7. Results là JSON trên stdout (progress trên stderr) để track regressions.
+//
+// Usage: AssignmentBenchmark [--max-size N] [--repetitions R] [--threads T] [--catalog-size K]
+#include "src/application/services/ActivityAssignmentService.h"
+#include "src/application/strategies/AssignmentKernel.h"
+#include "src/application/strategies/IRandomSelectionStrategy.h"
+#include "src/domain/repositories/IActivityRepository.h"
+#include "src/domain/repositories/IStudentRepository.h"
+#include "src/infrastructure/repositories/FileActivityRepository.h"
+#include "src/infrastructure/repositories/FileStudentRepository.h"
+#include "src/infrastructure/repositories/MappedStudentRepository.h"
+#include "src/presentation/writers/ResultWriter.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace tools::benchmark {
+
+constexpr std::uint64_t BENCHMARK_SEED = 42;
+
+// Category counts của category scaling cases, chạy tới roster size này
+constexpr std::array<std::size_t, 3> CATEGORY_SCALING_COUNTS = { 3, 12, 48 };
+constexpr std::size_t CATEGORY_SCALING_MAX_SIZE = 1'000'000;
+
+struct Options {
+    std::size_t maxSize = 10'000'000;
+    std::size_t repetitions = 3;
+    std::size_t threadCount = 0;
+    std::size_t catalogSize = 12;
+};
+
+// Một benchmark case ở một size; items = số đơn vị công việc (students, draws, lines)
+struct Measurement {
+    std::string name;
+    std::size_t size;
+    std::size_t items;
+    std::vector<std::chrono::nanoseconds> samples;
+};
+
+// Streambuf bỏ hết output, để đo formatting mà không đo disk
+class NullBuffer : public std::streambuf {
+protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char* /*data*/, std::streamsize count) override { return count; }
+};
+
+// Giữ results để compiler không loại bỏ work được đo
+volatile std::uint64_t sink = 0;
+
+template <typename T>
+[[nodiscard]] std::optional<T> parseNumber(std::string_view value)
+{
+    T number {};
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc {} || ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+[[nodiscard]] std::optional<Options> parseArguments(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto value = i + 1 < argc ? parseNumber<std::size_t>(argv[i + 1]) : std::nullopt;
+        if (!value) {
+            std::cerr << "Usage: AssignmentBenchmark [--max-size N] [--repetitions R]"
+                      << " [--threads T] [--catalog-size K]\n";
+            return std::nullopt;
+        }
+        ++i;
+
+        if (arg == "--max-size" && *value > 0) {
+            options.maxSize = *value;
+        } else if (arg == "--repetitions" && *value > 0) {
+            options.repetitions = *value;
+        } else if (arg == "--threads") {
+            options.threadCount = *value;
+        } else if (arg == "--catalog-size" && *value >= domain::entities::BUILTIN_CATEGORIES.size()) {
+            options.catalogSize = *value;
+        } else {
+            std::cerr << "Invalid argument: " << arg << " " << argv[i] << "\n";
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+// Roster N students với 8-digit IDs liên tiếp; duplicateEvery > 0: mỗi dòng thứ
+// duplicateEvery lặp lại ID của một dòng trước đó
+void writeRoster(const std::filesystem::path& path, std::size_t size, std::size_t duplicateEvery = 0)
+{
+    std::ofstream file(path, std::ios::binary);
+    std::string buffer;
+    buffer.reserve(size * 9);
+    for (std::size_t i = 0; i < size; ++i) {
+        const bool duplicate = duplicateEvery > 0 && i % duplicateEvery == duplicateEvery - 1;
+        buffer += std::to_string(10'000'000 + (duplicate ? i / 2 : i) % 90'000'000);
+        buffer += '\n';
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+// Catalog K activities, chia đều round-robin qua categoryCount categories: built-in
+// categories trước, sau đó "Category<c>"
+void writeCatalog(const std::filesystem::path& path, std::size_t size,
+    std::size_t categoryCount = domain::entities::BUILTIN_CATEGORIES.size())
+{
+    std::ofstream file(path, std::ios::binary);
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::size_t c = i % categoryCount;
+        file << "Activity " << i << ",";
+        if (c < domain::entities::BUILTIN_CATEGORIES.size()) {
+            file << domain::entities::Activity::categoryToString(domain::entities::BUILTIN_CATEGORIES[c]);
+        } else {
+            file << "Category" << c;
+        }
+        file << "\n";
+    }
+}
+
+[[nodiscard]] Measurement measure(std::string name, std::size_t size, std::size_t items,
+    std::size_t repetitions, const std::function<std::uint64_t()>& body)
+{
+    Measurement measurement { .name = std::move(name), .size = size, .items = items, .samples = {} };
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        sink = sink + body();
+        measurement.samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start));
+    }
+    std::ranges::sort(measurement.samples);
+
+    std::cerr << "  " << measurement.name << " n=" << size << ": "
+              << std::chrono::duration<double, std::milli>(measurement.samples.front()).count() << " ms\n";
+    return measurement;
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Measurement>& measurements)
+{
+    out << "{\n  \"benchmark\": \"StudentActivityAssignment\",\n"
+        << "  \"repetitions\": " << options.repetitions << ",\n"
+        << "  \"threads\": " << options.threadCount << ",\n"
+        << "  \"catalog_size\": " << options.catalogSize << ",\n"
+        << "  \"results\": [\n";
+
+    for (std::size_t i = 0; i < measurements.size(); ++i) {
+        const auto& m = measurements[i];
+        const auto minimum = static_cast<double>(m.samples.front().count());
+        const auto median = static_cast<double>(m.samples[m.samples.size() / 2].count());
+        const auto items = static_cast<double>(std::max<std::size_t>(m.items, 1));
+
+        out << "    {\"name\": \"" << m.name << "\", \"size\": " << m.size
+            << ", \"items\": " << m.items
+            << ", \"min_ns\": " << static_cast<std::uint64_t>(minimum)
+            << ", \"median_ns\": " << static_cast<std::uint64_t>(median)
+            << ", \"ns_per_item\": " << minimum / items
+            << ", \"items_per_second\": " << (minimum > 0 ? items * 1e9 / minimum : 0.0) << "}"
+            << (i + 1 < measurements.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Categories của kernel benchmark, cùng thứ tự với service
+constexpr auto KERNEL_CATEGORIES = domain::entities::BUILTIN_CATEGORIES;
+
+// Virtual path (một selectActivitiesFor per category per block) so với compile-time kernel
+// trên cùng strategy; hai paths phải cho cùng rows
+template <typename Strategy>
+void measureKernels(const std::string& strategyName, const domain::entities::ActivityIndex& catalog,
+    std::size_t size, std::size_t reps, std::vector<Measurement>& measurements)
+{
+    constexpr std::size_t blockSize = application::strategies::DRAW_STRATUM_SIZE;
+    Strategy strategy { BENCHMARK_SEED };
+    strategy.prepare(catalog);
+
+    // Row-major rows, KERNEL_CATEGORIES.size() ids per student
+    constexpr std::size_t stride = KERNEL_CATEGORIES.size();
+    std::vector<domain::entities::ActivityId> dynamicRows(size * stride);
+    std::vector<domain::entities::ActivityId> staticRows(size * stride);
+    std::vector<domain::entities::ActivityId> draws(blockSize * stride);
+    const application::strategies::IRandomSelectionStrategy& dynamicStrategy = strategy;
+
+    measurements.push_back(measure("kernel_dynamic_" + strategyName, size, size, reps, [&] {
+        for (std::size_t begin = 0; begin < size; begin += blockSize) {
+            const std::size_t count = std::min(blockSize, size - begin);
+            const application::strategies::DrawContext context { BENCHMARK_SEED, begin, size };
+            for (std::size_t c = 0; c < KERNEL_CATEGORIES.size(); ++c) {
+                auto column = std::span(draws).subspan(c * count, count);
+                if (!dynamicStrategy.selectActivitiesFor(catalog, KERNEL_CATEGORIES[c], context, column)) {
+                    return std::uint64_t { 0 };
+                }
+            }
+            for (std::size_t k = 0; k < count; ++k) {
+                for (std::size_t c = 0; c < stride; ++c) {
+                    dynamicRows[(begin + k) * stride + c] = draws[c * count + k];
+                }
+            }
+        }
+        return std::uint64_t { dynamicRows.back() };
+    }));
+
+    measurements.push_back(measure("kernel_static_" + strategyName, size, size, reps, [&] {
+        const application::strategies::DrawContext context { BENCHMARK_SEED, 0, size };
+        const bool drawn = application::strategies::runAssignmentKernel<KERNEL_CATEGORIES>(
+            strategy, catalog, context, std::span(staticRows));
+        return drawn ? std::uint64_t { staticRows.back() } : 0;
+    }));
+
+    if (dynamicRows != staticRows) {
+        throw std::runtime_error("kernel results differ from virtual path for " + strategyName);
+    }
+}
+
+[[nodiscard]] std::vector<std::pair<std::string, std::function<std::unique_ptr<application::strategies::IRandomSelectionStrategy>()>>>
+strategyFactories()
+{
+    return {
+        { "standard", [] { return application::strategies::createStandardRandomStrategy(BENCHMARK_SEED); } },
+        { "weighted", [] { return application::strategies::createWeightedRandomStrategy(BENCHMARK_SEED); } },
+        { "balanced", [] { return application::strategies::createBalancedRandomStrategy(BENCHMARK_SEED); } },
+    };
+}
+
+void runSize(const Options& options, std::size_t size, const std::filesystem::path& directory,
+    std::vector<Measurement>& measurements)
+{
+    const auto rosterPath = directory / "students.txt";
+    const auto catalogPath = directory / "activities.txt";
+    writeRoster(rosterPath, size);
+    writeCatalog(catalogPath, options.catalogSize);
+
+    const std::size_t reps = options.repetitions;
+
+    // Parsing
+    auto mapped = domain::repositories::createMappedStudentRepository(rosterPath.string());
+    auto streamed = domain::repositories::createFileStudentRepository(rosterPath.string());
+    measurements.push_back(measure("roster_parse_mmap", size, size, reps, [&] {
+        const auto students = mapped->loadStudents(std::pmr::get_default_resource());
+        return students ? students->size() : 0;
+    }));
+    measurements.push_back(measure("roster_parse_stream", size, size, reps, [&] {
+        const auto students = streamed->loadStudents(std::pmr::get_default_resource());
+        return students ? students->size() : 0;
+    }));
+
+    // Chunked parsing trên options.threadCount workers; roster phải giống parse tuần tự
+    if (options.threadCount > 1) {
+        auto parallel = domain::repositories::createMappedStudentRepository(rosterPath.string(), options.threadCount);
+        measurements.push_back(measure("roster_parse_mmap_parallel", size, size, reps, [&] {
+            const auto students = parallel->loadStudents(std::pmr::get_default_resource());
+            return students ? students->size() : 0;
+        }));
+        if (parallel->loadStudents(std::pmr::get_default_resource()) != mapped->loadStudents(std::pmr::get_default_resource())) {
+            throw std::runtime_error("parallel roster parse differs");
+        }
+    }
+
+    // Catalog parsing scale theo số activities, cap để file không quá lớn
+    const std::size_t catalogParseSize = std::min<std::size_t>(size, 1'000'000);
+    const auto largeCatalogPath = directory / "catalog_parse.txt";
+    writeCatalog(largeCatalogPath, catalogParseSize);
+    auto catalogRepo = domain::repositories::createFileActivityRepository(largeCatalogPath.string());
+    measurements.push_back(measure("catalog_parse", catalogParseSize, catalogParseSize, reps, [&] {
+        return catalogRepo->loadActivities().value_or(std::vector<domain::entities::Activity> {}).size();
+    }));
+    if (options.threadCount > 1) {
+        auto parallelCatalogRepo = domain::repositories::createFileActivityRepository(
+            largeCatalogPath.string(), options.threadCount);
+        measurements.push_back(measure("catalog_parse_parallel", catalogParseSize, catalogParseSize, reps, [&] {
+            return parallelCatalogRepo->loadActivities().value_or(std::vector<domain::entities::Activity> {}).size();
+        }));
+        if (parallelCatalogRepo->loadActivities() != catalogRepo->loadActivities()) {
+            throw std::runtime_error("parallel catalog parse differs");
+        }
+    }
+    std::filesystem::remove(largeCatalogPath);
+
+    auto activities = domain::repositories::createFileActivityRepository(catalogPath.string())->loadActivities();
+    const domain::entities::ActivityIndex catalog { std::move(*activities) };
+    const auto category = domain::entities::ActivityCategory::Class;
+
+    // Strategies: stateful per-draw và counter-based batch
+    std::vector<domain::entities::ActivityId> draws(size);
+    for (const auto& [strategyName, factory] : strategyFactories()) {
+        auto strategy = factory();
+        strategy->prepare(catalog);
+
+        measurements.push_back(measure("draw_single_" + strategyName, size, size, reps, [&] {
+            std::uint64_t checksum = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                checksum += strategy->selectRandomActivity(catalog, category).value_or(0);
+            }
+            return checksum;
+        }));
+
+        measurements.push_back(measure("draw_batch_" + strategyName, size, size, reps, [&] {
+            const application::strategies::DrawContext context { BENCHMARK_SEED, 0, size };
+            const bool drawn = strategy->selectActivitiesFor(catalog, category, context, draws);
+            return drawn ? std::uint64_t { draws.back() } : 0;
+        }));
+    }
+
+    // Kernel: compile-time specialized so với virtual per-category calls
+    measureKernels<application::strategies::StandardRandomStrategy>("standard", catalog, size, reps, measurements);
+    measureKernels<application::strategies::WeightedRandomStrategy>("weighted", catalog, size, reps, measurements);
+    measureKernels<application::strategies::BalancedRandomStrategy>("balanced", catalog, size, reps, measurements);
+
+    // Full run: load + index + assign + teardown của run trước, không output;
+    // cả hai kernel paths, run arena so với allocate thẳng từ default resource
+    std::optional<application::services::ActivityAssignmentService::AssignmentSet> lastAssignment;
+    auto runFull = [&](const application::services::ActivityAssignmentService& service) {
+        // AssignmentSet không assignable (giữ run arena): release set cũ rồi emplace
+        lastAssignment.reset();
+        if (auto assignment = service.assignActivitiesToStudents()) {
+            lastAssignment.emplace(std::move(*assignment));
+        }
+        return lastAssignment ? lastAssignment->results.size() : 0;
+    };
+
+    for (const auto& [strategyName, factory] : strategyFactories()) {
+        application::services::ActivityAssignmentService service(
+            domain::repositories::createMappedStudentRepository(rosterPath.string()),
+            domain::repositories::createFileActivityRepository(catalogPath.string()),
+            factory());
+        service.setThreadCount(options.threadCount);
+
+        service.setSpecializedKernel(false);
+        measurements.push_back(measure("assign_full_dynamic_" + strategyName, size, size, reps,
+            [&] { return runFull(service); }));
+        const auto dynamicAssignment = std::move(lastAssignment);
+        lastAssignment.reset();
+
+        service.setSpecializedKernel(true);
+        service.setRunArena(false);
+        measurements.push_back(measure("assign_full_heap_" + strategyName, size, size, reps,
+            [&] { return runFull(service); }));
+        const auto heapAssignment = std::move(lastAssignment);
+        lastAssignment.reset();
+
+        service.setRunArena(true);
+        measurements.push_back(measure("assign_full_" + strategyName, size, size, reps,
+            [&] { return runFull(service); }));
+
+        if (!dynamicAssignment || !heapAssignment || !lastAssignment
+            || !std::ranges::equal(dynamicAssignment->results.activityIds(), lastAssignment->results.activityIds())
+            || !std::ranges::equal(heapAssignment->results.activityIds(), lastAssignment->results.activityIds())) {
+            throw std::runtime_error("assignment differs between kernel paths or allocators for " + strategyName);
+        }
+    }
+
+    // Incremental rerun trên state của run đầu, roster có duplicate IDs: mọi assignment
+    // phải được giữ nguyên
+    {
+        const auto duplicatesPath = directory / "students_duplicates.txt";
+        writeRoster(duplicatesPath, size, 100);
+        application::services::ActivityAssignmentService service(
+            domain::repositories::createMappedStudentRepository(duplicatesPath.string()),
+            domain::repositories::createFileActivityRepository(catalogPath.string()),
+            application::strategies::createStandardRandomStrategy(BENCHMARK_SEED));
+        service.setThreadCount(options.threadCount);
+
+        const auto initial = service.assignActivitiesIncrementally({});
+        std::optional<application::services::ActivityAssignmentService::IncrementalAssignment> rerun;
+        if (initial) {
+            measurements.push_back(measure("assign_incremental_rerun", size, size, reps, [&] {
+                rerun.reset();
+                if (auto incremental = service.assignActivitiesIncrementally(initial->state)) {
+                    rerun.emplace(std::move(*incremental));
+                }
+                return rerun ? rerun->stats.keptCount : 0;
+            }));
+        }
+        if (!rerun || rerun->stats.assignedCount != 0
+            || !std::ranges::equal(initial->assignment.results.activityIds(), rerun->assignment.results.activityIds())) {
+            throw std::runtime_error("incremental rerun changed existing assignments");
+        }
+        std::filesystem::remove(duplicatesPath);
+    }
+
+    // Category scaling: cùng roster với catalogs nhiều categories hơn (dynamic path);
+    // items = draws nên ns_per_item giữ gần như không đổi khi cost tuyến tính theo categories.
+    // Cap size vì results tăng theo size * categories
+    if (size <= CATEGORY_SCALING_MAX_SIZE) {
+        for (std::size_t categoryCount : CATEGORY_SCALING_COUNTS) {
+            const auto scalingCatalogPath = directory / "catalog_categories.txt";
+            writeCatalog(scalingCatalogPath, categoryCount * 4, categoryCount);
+            application::services::ActivityAssignmentService service(
+                domain::repositories::createMappedStudentRepository(rosterPath.string()),
+                domain::repositories::createFileActivityRepository(scalingCatalogPath.string()),
+                application::strategies::createStandardRandomStrategy(BENCHMARK_SEED));
+            service.setThreadCount(options.threadCount);
+
+            measurements.push_back(measure("assign_categories_" + std::to_string(categoryCount),
+                size, size * categoryCount, reps, [&] {
+                    auto assignment = service.assignActivitiesToStudents();
+                    return assignment ? assignment->results.activityIds().size() : 0;
+                }));
+            std::filesystem::remove(scalingCatalogPath);
+        }
+    }
+
+    // Output formatting qua ResultWriter, không tính disk
+    if (lastAssignment) {
+        NullBuffer nullBuffer;
+        std::ostream nullStream(&nullBuffer);
+        measurements.push_back(measure("output_write", size, size, reps, [&] {
+            presentation::writers::ResultWriter writer(nullStream, lastAssignment->catalog);
+            writer.write(*lastAssignment->students, lastAssignment->results);
+            writer.flush();
+            return writer.getBytesWritten();
+        }));
+    }
+
+    std::filesystem::remove(rosterPath);
+    std::filesystem::remove(catalogPath);
+}
+
+} // namespace tools::benchmark
+
+int main(int argc, char* argv[])
+{
+    using namespace tools::benchmark;
+
+    auto options = parseArguments(argc, argv);
+    if (!options) {
+        return 1;
+    }
+
+    // Input files trong một temp directory riêng cho process này
+    std::string directoryName = "saa-benchmark";
+#if defined(__unix__) || defined(__APPLE__)
+    directoryName.append("-").append(std::to_string(::getpid()));
+#endif
+    const auto directory = std::filesystem::temp_directory_path() / directoryName;
+    std::filesystem::create_directories(directory);
+
+    std::vector<Measurement> measurements;
+    try {
+        for (std::size_t size = 1'000; size <= options->maxSize; size *= 10) {
+            std::cerr << "size " << size << "\n";
+            runSize(*options, size, directory, measurements);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        std::filesystem::remove_all(directory);
+        return 1;
+    }
+
+    std::filesystem::remove_all(directory);
+    writeJson(std::cout, *options, measurements);
+    return 0;
+}
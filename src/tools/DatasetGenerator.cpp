@@ -0,0 +1,519 @@
+// Synthetic dataset generator: rosters (8-digit IDs với prefixes, duplicates và malformed
+// lines) và catalogs (category skew, name lengths, capacities) tới hàng trăm triệu dòng.
+// Output được stream qua một fixed buffer, không giữ dataset trong memory.
+//
+// Usage: DatasetGenerator roster  --count N [--prefixes 24,25] [--duplicate-rate R]
+//                                 [--malformed-rate R] [--order sequential|scattered]
+//                                 [--seed S] [--output PATH]
+//        DatasetGenerator catalog --count N [--categories K | --category-skew W1:W2:...]
+//                                 [--name-length MIN:MAX]
+//                                 [--capacity MIN:MAX] [--capacity-rate R]
+//                                 [--seed S] [--output PATH]
+// WeightedRandomStrategy weight theo name length, nên --name-length cũng là weight range.
+// Categories: Class, Union, School rồi Category3, Category4, ... (mặc định 3 categories đều nhau).
+#include "src/application/strategies/CounterBasedRng.h"
+#include "src/domain/entities/Activity.h"
+#include "src/domain/entities/ActivityIndex.h"
+#include "src/domain/entities/Student.h"
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tools::generator {
+
+// Output buffer size; một fwrite mỗi MiB
+constexpr std::size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+// Dài nhất một dòng có thể có (catalog name + category + capacity)
+constexpr std::size_t MAX_LINE_LENGTH = 512;
+
+// Số categories tối đa của một generated catalog ("Category<c>" vẫn vừa một line)
+constexpr std::size_t MAX_GENERATED_CATEGORIES = 10'000;
+
+struct RosterOptions {
+    std::size_t count = 0;
+    std::vector<std::string> prefixes;
+    double duplicateRate = 0.0;
+    double malformedRate = 0.0;
+    bool scattered = true;
+};
+
+struct CatalogOptions {
+    std::size_t count = 0;
+    std::vector<double> categorySkew; // Một weight per category
+    std::size_t minNameLength = 8;
+    std::size_t maxNameLength = 24;
+    std::optional<std::pair<std::uint32_t, std::uint32_t>> capacityRange;
+    double capacityRate = 1.0;
+};
+
+// 64-bit draws trên Philox engine của strategies, deterministic theo seed
+class DatasetRandom {
+public:
+    explicit DatasetRandom(std::uint64_t seed) noexcept : engine_(seed, 0) { }
+
+    [[nodiscard]] std::uint64_t next() noexcept
+    {
+        const std::uint64_t high = engine_();
+        return (high << 32) | engine_();
+    }
+
+    // Uniform trong [0, bound)
+    [[nodiscard]] std::uint64_t below(std::uint64_t bound) noexcept
+    {
+        return application::strategies::boundedIndex(next(), bound);
+    }
+
+    [[nodiscard]] double unit() noexcept
+    {
+        return application::strategies::unitInterval(next());
+    }
+
+    // true với xác suất rate
+    [[nodiscard]] bool chance(double rate) noexcept
+    {
+        return rate > 0.0 && unit() < rate;
+    }
+
+private:
+    application::strategies::PhiloxEngine engine_;
+};
+
+// Buffered writer tới stdout hoặc file; lỗi I/O được giữ lại tới finish()
+class OutputStream {
+public:
+    [[nodiscard]] static std::optional<OutputStream> open(const std::string& path)
+    {
+        std::FILE* file = path.empty() ? stdout : std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            return std::nullopt;
+        }
+        return OutputStream(file, !path.empty());
+    }
+
+    OutputStream(OutputStream&& other) noexcept
+        : file_(std::exchange(other.file_, nullptr))
+        , owned_(other.owned_)
+        , buffer_(std::move(other.buffer_))
+        , used_(other.used_)
+        , bytesWritten_(other.bytesWritten_)
+        , failed_(other.failed_)
+    {
+    }
+
+    OutputStream& operator=(OutputStream&&) = delete;
+
+    ~OutputStream()
+    {
+        if (owned_ && file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    // Chỗ trống cho ít nhất MAX_LINE_LENGTH bytes
+    [[nodiscard]] char* reserve()
+    {
+        if (OUTPUT_BUFFER_SIZE - used_ < MAX_LINE_LENGTH) {
+            drain();
+        }
+        return buffer_.data() + used_;
+    }
+
+    void commit(std::size_t length) noexcept
+    {
+        used_ += length;
+    }
+
+    [[nodiscard]] bool finish()
+    {
+        drain();
+        if (std::fflush(file_) != 0) {
+            failed_ = true;
+        }
+        return !failed_;
+    }
+
+    [[nodiscard]] std::uint64_t getBytesWritten() const noexcept { return bytesWritten_ + used_; }
+
+private:
+    OutputStream(std::FILE* file, bool owned)
+        : file_(file)
+        , owned_(owned)
+        , buffer_(OUTPUT_BUFFER_SIZE)
+    {
+    }
+
+    void drain()
+    {
+        if (used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_) {
+            failed_ = true;
+        }
+        bytesWritten_ += used_;
+        used_ = 0;
+    }
+
+    std::FILE* file_;
+    bool owned_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::uint64_t bytesWritten_ = 0;
+    bool failed_ = false;
+};
+
+template <typename T>
+[[nodiscard]] std::optional<T> parseNumber(std::string_view value)
+{
+    T number {};
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc {} || ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+// Tách "a<sep>b<sep>c" thành các phần
+[[nodiscard]] std::vector<std::string_view> split(std::string_view value, char separator)
+{
+    std::vector<std::string_view> parts;
+    std::size_t start = 0;
+    while (true) {
+        const auto pos = value.find(separator, start);
+        parts.push_back(value.substr(start, pos == std::string_view::npos ? std::string_view::npos : pos - start));
+        if (pos == std::string_view::npos) {
+            return parts;
+        }
+        start = pos + 1;
+    }
+}
+
+[[nodiscard]] std::optional<double> parseRate(std::string_view value)
+{
+    auto rate = parseNumber<double>(value);
+    if (!rate || *rate < 0.0 || *rate > 1.0) {
+        return std::nullopt;
+    }
+    return rate;
+}
+
+template <typename T>
+[[nodiscard]] std::optional<std::pair<T, T>> parseRange(std::string_view value)
+{
+    auto parts = split(value, ':');
+    if (parts.size() != 2) {
+        return std::nullopt;
+    }
+    auto low = parseNumber<T>(parts[0]);
+    auto high = parseNumber<T>(parts[1]);
+    if (!low || !high || *low > *high) {
+        return std::nullopt;
+    }
+    return std::pair { *low, *high };
+}
+
+// Một prefix của roster: base ID và số suffixes phân biệt (suffix space)
+struct Prefix {
+    std::uint32_t base;
+    std::uint32_t space;
+    std::uint32_t stride; // Coprime với space, cho scattered order
+    std::uint64_t emitted = 0;
+};
+
+[[nodiscard]] std::optional<std::vector<Prefix>> buildPrefixes(const std::vector<std::string>& values)
+{
+    std::vector<Prefix> prefixes;
+    for (const auto& value : values) {
+        if (value.size() >= domain::entities::Student::ID_LENGTH
+            || value.find_first_not_of("0123456789") != std::string::npos) {
+            return std::nullopt;
+        }
+
+        std::uint32_t space = 1;
+        for (std::size_t i = value.size(); i < domain::entities::Student::ID_LENGTH; ++i) {
+            space *= 10;
+        }
+        const std::uint32_t base = (value.empty() ? 0 : *parseNumber<std::uint32_t>(value)) * space;
+
+        // Stride gần golden ratio của space; coprime với 10^k khi không chia hết cho 2 và 5
+        auto stride = static_cast<std::uint32_t>(static_cast<double>(space) * 0.6180339887) | 1u;
+        while (std::gcd(stride, space) != 1) {
+            stride += 2;
+        }
+        prefixes.push_back({ base, space, stride });
+    }
+    return prefixes;
+}
+
+// Malformed variants mà roster parsers phải bỏ qua
+constexpr std::array<std::string_view, 5> MALFORMED_LINES = {
+    "1234567", "123456789", "12A45678", "1234 5678", "student",
+};
+
+[[nodiscard]] bool generateRoster(const RosterOptions& options, DatasetRandom& rng, OutputStream& out)
+{
+    auto prefixes = buildPrefixes(options.prefixes.empty() ? std::vector<std::string> { "" } : options.prefixes);
+    if (!prefixes) {
+        std::cerr << "Invalid prefix: prefixes must be 0-7 digits\n";
+        return false;
+    }
+
+    std::uint64_t capacity = 0;
+    for (const auto& prefix : *prefixes) {
+        capacity += prefix.space;
+    }
+    if (options.count > capacity) {
+        std::cerr << "Warning: " << options.count << " lines exceed " << capacity
+                  << " distinct IDs; IDs will repeat\n";
+    }
+
+    for (std::size_t line = 0; line < options.count; ++line) {
+        char* cursor = out.reserve();
+
+        if (options.malformedRate > 0.0 && rng.chance(options.malformedRate)) {
+            const auto malformed = MALFORMED_LINES[rng.below(MALFORMED_LINES.size())];
+            std::memcpy(cursor, malformed.data(), malformed.size());
+            cursor[malformed.size()] = '\n';
+            out.commit(malformed.size() + 1);
+            continue;
+        }
+
+        auto& prefix = (*prefixes)[prefixes->size() == 1 ? 0 : rng.below(prefixes->size())];
+
+        // Duplicate = một index đã emit trước đó của cùng prefix
+        std::uint64_t index = prefix.emitted;
+        if (prefix.emitted > 0 && options.duplicateRate > 0.0 && rng.chance(options.duplicateRate)) {
+            index = rng.below(prefix.emitted);
+        } else {
+            ++prefix.emitted;
+        }
+
+        const std::uint64_t suffix = options.scattered
+            ? (index * prefix.stride) % prefix.space
+            : index % prefix.space;
+
+        const domain::entities::Student student { static_cast<domain::entities::Student::PackedId>(prefix.base + suffix) };
+        student.writeId(std::span<char, domain::entities::Student::ID_LENGTH>(cursor, domain::entities::Student::ID_LENGTH));
+        cursor[domain::entities::Student::ID_LENGTH] = '\n';
+        out.commit(domain::entities::Student::ID_LENGTH + 1);
+    }
+    return true;
+}
+
+[[nodiscard]] bool generateCatalog(const CatalogOptions& options, DatasetRandom& rng, OutputStream& out)
+{
+    // Cumulative thresholds trên 2^64 cho category skew
+    const double total = std::accumulate(options.categorySkew.begin(), options.categorySkew.end(), 0.0);
+    std::vector<std::string> categoryNames(options.categorySkew.size());
+    std::vector<double> cumulative(options.categorySkew.size());
+    double running = 0.0;
+    for (std::size_t c = 0; c < cumulative.size(); ++c) {
+        categoryNames[c] = c < domain::entities::BUILTIN_CATEGORIES.size()
+            ? domain::entities::Activity::categoryToString(domain::entities::BUILTIN_CATEGORIES[c])
+            : "Category" + std::to_string(c);
+        running += options.categorySkew[c] / total;
+        cumulative[c] = running;
+    }
+
+    // Mỗi category cần ít nhất một activity để assignment chạy được
+    const std::size_t guaranteed = options.count >= cumulative.size() ? cumulative.size() : 0;
+
+    constexpr std::string_view filler = "abcdefghijklmnopqrstuvwxyz";
+    for (std::size_t i = 0; i < options.count; ++i) {
+        std::size_t category = 0;
+        if (i < guaranteed) {
+            category = i;
+        } else {
+            const double draw = rng.unit();
+            while (category + 1 < cumulative.size() && draw >= cumulative[category]) {
+                ++category;
+            }
+        }
+
+        char* cursor = out.reserve();
+        char* const lineStart = cursor;
+
+        // Name = "Activity <i>" (unique) rồi pad tới length đã draw
+        const std::size_t targetLength = options.minNameLength
+            + rng.below(options.maxNameLength - options.minNameLength + 1);
+        std::memcpy(cursor, "Activity ", 9);
+        cursor = std::to_chars(cursor + 9, cursor + 32, i).ptr;
+        for (std::size_t length = static_cast<std::size_t>(cursor - lineStart); length < targetLength; ++length) {
+            *cursor++ = filler[length % filler.size()];
+        }
+
+        *cursor++ = ',';
+        const auto& categoryName = categoryNames[category];
+        std::memcpy(cursor, categoryName.data(), categoryName.size());
+        cursor += categoryName.size();
+
+        if (options.capacityRange && rng.chance(options.capacityRate)) {
+            const auto [low, high] = *options.capacityRange;
+            *cursor++ = ',';
+            cursor = std::to_chars(cursor, cursor + 16, low + rng.below(std::uint64_t { high } - low + 1)).ptr;
+        }
+
+        *cursor++ = '\n';
+        out.commit(static_cast<std::size_t>(cursor - lineStart));
+    }
+    return true;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: DatasetGenerator roster  --count N [--prefixes 24,25] [--duplicate-rate R]\n"
+              << "                                [--malformed-rate R] [--order sequential|scattered]\n"
+              << "                                [--seed S] [--output PATH]\n"
+              << "       DatasetGenerator catalog --count N [--categories K | --category-skew W1:W2:...]\n"
+              << "                                [--name-length MIN:MAX]\n"
+              << "                                [--capacity MIN:MAX] [--capacity-rate R]\n"
+              << "                                [--seed S] [--output PATH]\n";
+}
+
+} // namespace tools::generator
+
+int main(int argc, char* argv[])
+{
+    using namespace tools::generator;
+
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string_view mode = argv[1];
+    if (mode != "roster" && mode != "catalog") {
+        printUsage();
+        return 1;
+    }
+
+    RosterOptions roster;
+    CatalogOptions catalog;
+    catalog.categorySkew.assign(domain::entities::BUILTIN_CATEGORIES.size(), 1.0);
+    std::uint64_t seed = 42;
+    std::string outputPath;
+    std::optional<std::size_t> count;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        const std::string_view value = argv[++i];
+        bool valid = true;
+
+        if (arg == "--count") {
+            count = parseNumber<std::size_t>(value);
+            valid = count.has_value();
+        } else if (arg == "--seed") {
+            auto parsed = parseNumber<std::uint64_t>(value);
+            valid = parsed.has_value();
+            seed = parsed.value_or(seed);
+        } else if (arg == "--output") {
+            outputPath = value;
+        } else if (mode == "roster" && arg == "--prefixes") {
+            roster.prefixes.clear();
+            for (auto part : split(value, ',')) {
+                roster.prefixes.emplace_back(part);
+            }
+        } else if (mode == "roster" && arg == "--duplicate-rate") {
+            auto rate = parseRate(value);
+            valid = rate.has_value();
+            roster.duplicateRate = rate.value_or(0.0);
+        } else if (mode == "roster" && arg == "--malformed-rate") {
+            auto rate = parseRate(value);
+            valid = rate.has_value();
+            roster.malformedRate = rate.value_or(0.0);
+        } else if (mode == "roster" && arg == "--order") {
+            valid = value == "sequential" || value == "scattered";
+            roster.scattered = value == "scattered";
+        } else if (mode == "catalog" && arg == "--categories") {
+            auto categories = parseNumber<std::size_t>(value);
+            valid = categories && *categories >= 1 && *categories <= MAX_GENERATED_CATEGORIES;
+            if (valid) {
+                catalog.categorySkew.assign(*categories, 1.0);
+            }
+        } else if (mode == "catalog" && arg == "--category-skew") {
+            auto parts = split(value, ':');
+            valid = !parts.empty() && parts.size() <= MAX_GENERATED_CATEGORIES;
+            catalog.categorySkew.assign(parts.size(), 0.0);
+            double total = 0.0;
+            for (std::size_t c = 0; valid && c < parts.size(); ++c) {
+                auto weight = parseNumber<double>(parts[c]);
+                valid = weight && *weight >= 0.0;
+                catalog.categorySkew[c] = weight.value_or(0.0);
+                total += catalog.categorySkew[c];
+            }
+            valid = valid && total > 0.0;
+        } else if (mode == "catalog" && arg == "--name-length") {
+            auto range = parseRange<std::size_t>(value);
+            // Tối thiểu đủ cho "Activity N", tối đa vừa một output line
+            valid = range && range->first >= 1 && range->second <= 256;
+            if (valid) {
+                catalog.minNameLength = range->first;
+                catalog.maxNameLength = range->second;
+            }
+        } else if (mode == "catalog" && arg == "--capacity") {
+            catalog.capacityRange = parseRange<std::uint32_t>(value);
+            valid = catalog.capacityRange && catalog.capacityRange->second < domain::entities::Activity::UNLIMITED_CAPACITY;
+        } else if (mode == "catalog" && arg == "--capacity-rate") {
+            auto rate = parseRate(value);
+            valid = rate.has_value();
+            catalog.capacityRate = rate.value_or(1.0);
+        } else {
+            std::cerr << "Unknown option for " << mode << ": " << arg << "\n";
+            printUsage();
+            return 1;
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return 1;
+        }
+    }
+
+    if (!count) {
+        std::cerr << "--count is required\n";
+        printUsage();
+        return 1;
+    }
+    roster.count = *count;
+    catalog.count = *count;
+
+    auto out = OutputStream::open(outputPath);
+    if (!out) {
+        std::cerr << "Cannot open output: " << outputPath << "\n";
+        return 1;
+    }
+
+    DatasetRandom rng(seed);
+    const auto start = std::chrono::steady_clock::now();
+    const bool generated = mode == "roster"
+        ? generateRoster(roster, rng, *out)
+        : generateCatalog(catalog, rng, *out);
+
+    if (!generated) {
+        return 1;
+    }
+    if (!out->finish()) {
+        std::cerr << "Write error: " << (outputPath.empty() ? "stdout" : outputPath) << "\n";
+        return 1;
+    }
+
+    // Summary qua stderr để stdout chỉ chứa dataset
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr << "Generated " << *count << " " << mode << " lines, " << out->getBytesWritten() << " bytes in "
+              << seconds << " s (" << (seconds > 0 ? static_cast<double>(out->getBytesWritten()) / seconds / 1e6 : 0.0)
+              << " MB/s)\n";
+    return 0;
+}
@@ -0,0 +1,252 @@
+// Load generator cho query server (--serve): closed-loop clients trên Unix socket,
+// đo latency per request và report p50/p90/p99/p99.9.
+//
+// Usage: QueryLoadGenerator --socket PATH [--ids FILE] [--connections N]
+//                           [--requests N] [--batch B]
+// --batch 1 gửi GET, --batch > 1 gửi MGET với B ids mỗi request.
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace tools::loadgen {
+
+struct Options {
+    std::string socketPath;
+    std::string idsFile = "data/students.txt";
+    std::size_t connections = 4;
+    std::size_t requests = 10000; // Per connection
+    std::size_t batch = 1;
+};
+
+// Latencies và số lookups của một connection
+struct ClientResult {
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::size_t lookups = 0;
+    std::size_t notFound = 0;
+    std::optional<std::string> error;
+};
+
+template <typename T>
+[[nodiscard]] std::optional<T> parseNumber(std::string_view value)
+{
+    T number {};
+    auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (ec != std::errc {} || ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return number;
+}
+
+[[nodiscard]] std::optional<Options> parseArguments(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return std::nullopt;
+        }
+        const std::string_view value = argv[++i];
+
+        std::optional<std::size_t> number;
+        if (arg == "--socket") {
+            options.socketPath = value;
+            continue;
+        }
+        if (arg == "--ids") {
+            options.idsFile = value;
+            continue;
+        }
+        number = parseNumber<std::size_t>(value);
+        if (!number || *number == 0) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return std::nullopt;
+        }
+        if (arg == "--connections") {
+            options.connections = *number;
+        } else if (arg == "--requests") {
+            options.requests = *number;
+        } else if (arg == "--batch") {
+            options.batch = *number;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return std::nullopt;
+        }
+    }
+
+    if (options.socketPath.empty()) {
+        std::cerr << "Usage: QueryLoadGenerator --socket PATH [--ids FILE] [--connections N]"
+                  << " [--requests N] [--batch B]\n";
+        return std::nullopt;
+    }
+    return options;
+}
+
+[[nodiscard]] int connectTo(const std::string& socketPath)
+{
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Closed loop: gửi một request, chờ đủ `batch` response lines, rồi gửi request tiếp theo
+[[nodiscard]] ClientResult runClient(const Options& options, const std::vector<std::string>& ids, std::size_t client)
+{
+    ClientResult result;
+    result.latencies.reserve(options.requests);
+
+    const int fd = connectTo(options.socketPath);
+    if (fd < 0) {
+        result.error = "Cannot connect to " + options.socketPath + ": " + std::strerror(errno);
+        return result;
+    }
+
+    std::string request;
+    std::string response;
+    char buffer[65536];
+
+    // Mỗi client bắt đầu ở offset khác nhau trong id list
+    std::size_t next = (client * ids.size()) / options.connections;
+
+    for (std::size_t r = 0; r < options.requests; ++r) {
+        request.assign(options.batch == 1 ? "GET" : "MGET");
+        for (std::size_t b = 0; b < options.batch; ++b) {
+            request += ' ';
+            request += ids[next];
+            next = (next + 1) % ids.size();
+        }
+        request += '\n';
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t sent = 0; sent < request.size();) {
+            const ssize_t written = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0) {
+                result.error = "Send failed";
+                ::close(fd);
+                return result;
+            }
+            sent += static_cast<std::size_t>(written);
+        }
+
+        response.clear();
+        std::size_t lines = 0;
+        while (lines < options.batch) {
+            const ssize_t length = ::recv(fd, buffer, sizeof(buffer), 0);
+            if (length <= 0) {
+                result.error = "Connection closed by server";
+                ::close(fd);
+                return result;
+            }
+            lines += static_cast<std::size_t>(std::count(buffer, buffer + length, '\n'));
+            response.append(buffer, static_cast<std::size_t>(length));
+        }
+        result.latencies.push_back(std::chrono::steady_clock::now() - start);
+
+        result.lookups += options.batch;
+        for (std::size_t pos = response.find("NOT_FOUND"); pos != std::string::npos;
+             pos = response.find("NOT_FOUND", pos + 1)) {
+            ++result.notFound;
+        }
+    }
+
+    ::close(fd);
+    return result;
+}
+
+[[nodiscard]] double percentileMicroseconds(
+    const std::vector<std::chrono::nanoseconds>& sorted, double percentile)
+{
+    const auto rank = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1));
+    return std::chrono::duration<double, std::micro>(sorted[rank]).count();
+}
+
+} // namespace tools::loadgen
+
+int main(int argc, char* argv[])
+{
+    using namespace tools::loadgen;
+
+    auto options = parseArguments(argc, argv);
+    if (!options) {
+        return 1;
+    }
+
+    std::vector<std::string> ids;
+    {
+        std::ifstream file(options->idsFile);
+        for (std::string line; std::getline(file, line);) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (!line.empty()) {
+                ids.push_back(std::move(line));
+            }
+        }
+    }
+    if (ids.empty()) {
+        std::cerr << "No student ids in " << options->idsFile << "\n";
+        return 1;
+    }
+
+    std::vector<ClientResult> results(options->connections);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> clients;
+        for (std::size_t c = 0; c < options->connections; ++c) {
+            clients.emplace_back([&, c] { results[c] = runClient(*options, ids, c); });
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::size_t lookups = 0;
+    std::size_t notFound = 0;
+    for (const auto& result : results) {
+        if (result.error) {
+            std::cerr << "Error: " << *result.error << "\n";
+            return 1;
+        }
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        lookups += result.lookups;
+        notFound += result.notFound;
+    }
+    std::ranges::sort(latencies);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "connections: " << options->connections << ", batch: " << options->batch << "\n"
+              << "requests: " << latencies.size() << " in " << seconds << " s ("
+              << static_cast<double>(latencies.size()) / seconds << " requests/s, "
+              << static_cast<double>(lookups) / seconds << " lookups/s)\n"
+              << "not found: " << notFound << "\n"
+              << "latency us: p50 " << percentileMicroseconds(latencies, 50.0)
+              << ", p90 " << percentileMicroseconds(latencies, 90.0)
+              << ", p99 " << percentileMicroseconds(latencies, 99.0)
+              << ", p99.9 " << percentileMicroseconds(latencies, 99.9)
+              << ", max " << percentileMicroseconds(latencies, 100.0) << "\n";
+    return 0;
+}